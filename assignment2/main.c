@@ -10,6 +10,8 @@
 #define NMAX 512
 #define DEBUG 0
 
+#include "../project/common/output.h"
+
 void check_int_scanf(int*, int);
 int read_graph(int*, int[NMAX][NMAX], int);
 void check_vertex_count(int, int);
@@ -60,9 +62,11 @@ int main(int argc, char* argv[]) {
     while(read_graph(&vertex_count, G, graph_num)) {
         check_graph(vertex_count, G, graph_num);
         print_graph(vertex_count, G);
+        output_flush();
 
         min_dom_set(0, &n_dominated, num_choice, num_dom, &size, dom, &min_size, min_dom, vertex_count, max_deg, G);
         print_dom_set(min_size, vertex_count, min_dom);
+        output_flush();
 
         graph_num++;
     }
@@ -203,11 +207,13 @@ void check_graph(int vertex_count, int G[NMAX][NMAX], int graph_num) {
 }
 
 // Prints the graph in an adjacency list format with degree and vertex count.
+// The output is buffered, see output_flush.
 // Parameters:
 //   vertex_count: the total number of vertices in the graph.
 //   G: the current graph being printed.
 void print_graph(int vertex_count, int G[NMAX][NMAX]) {
-    printf("%5d\n", vertex_count);    
+    output_int(vertex_count, 5);
+    output_char('\n');
 
     int i, j, deg_i;
     for(i = 0; i < vertex_count; i++) {
@@ -217,16 +223,16 @@ void print_graph(int vertex_count, int G[NMAX][NMAX]) {
                 deg_i++;
             }
         }
-        printf("%5d", deg_i);
+        output_int(deg_i, 5);
 
         for(j = 0; j < vertex_count; j++) {
             if(G[i][j] == 1) {
-                printf("%5d", j);
+                output_int(j, 5);
             }
         }
-        printf("\n");
+        output_char('\n');
     }
-    printf("\n");
+    output_char('\n');
 }
 
 // Recursively find the minimum dominating set
@@ -371,21 +377,25 @@ void min_dom_set(int level, int* n_dom, int num_choice[NMAX], int num_dom[NMAX],
 }
 
 // Print a dominating set.
+// The output is buffered, see output_flush.
 // Parameters:
 //   size: the size of the dominating set.
 //   vertex_count: the total number of vertices in the graph.
 //   dom: the dominating set.
 void print_dom_set(int size, int vertex_count, int* dom) {
-    printf("%5d\n", size);
+    output_int(size, 5);
+    output_char('\n');
 
     int i;
     for(i = 0; i < vertex_count; i++) {
         if(dom[i]) {
-            printf("%5d ", i);
+            output_int(i, 5);
+            output_char(' ');
         }
     }
 
-    printf("\n\n");
+    output_char('\n');
+    output_char('\n');
 }
 
 #if DEBUG
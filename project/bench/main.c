@@ -0,0 +1,584 @@
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// This program benchmarks the heuristics, and the exact solver of assignment 2, on a directory of inputs.
+// Every program is run on every input for each budget and seed. The heuristics are given --stats
+// and the statistics they print to standard error are collected, one row per graph:
+// the size found, the time to find it, the passes per second and the peak memory of the run.
+// The exact solver's verbose output is read instead, and it is run once per input as its
+// result does not depend on the budget or seed.
+//
+// Rows are written as CSV and JSON, and a summary per program and budget to standard output.
+// Given a baseline CSV from an earlier run, any graph whose set is larger or whose time to
+// best is more than --slowdown times longer is reported as a regression and the exit status is 1.
+//
+// Run it from this directory after building each program to a.out in its own directory.
+
+#include "../common/timer.h"
+
+#define EXACT "exact"
+#define DEFAULT_PROGRAMS "random,bfs,greedy,custom,ant,portfolio"
+#define DEFAULT_INPUTS "../custom/inputs"
+
+// Times below this many seconds are too short to compare against the baseline.
+#define TIME_SLACK 0.05
+
+// Seconds between checks on a running program.
+#define POLL_INTERVAL 0.01
+
+// The result of one graph of one run.
+struct row {
+    char program[64];
+    char input[256];
+    int budget;
+    unsigned long seed;
+    int graph;
+    int vertices;
+    int size;
+    int bound; // -1 for the exact solver
+    double time_to_best; // -1 if unknown
+    double seconds; // -1 if unknown
+    long passes;
+    long moves;
+    double run_seconds; // wall time of the whole run
+    long peak_rss_kb; // of the whole run
+};
+
+struct rows {
+    struct row* rows;
+    int count;
+    int capacity;
+};
+
+// A finished run, its output in files rewound to the start.
+struct run {
+    FILE* out;
+    FILE* err;
+    double seconds;
+    long peak_rss_kb;
+    int timed_out;
+    int failed;
+};
+
+int split_list(const char*, char**, int);
+int is_input(const struct dirent*);
+struct row* add_row(struct rows*);
+void start_program(const char*, const char*, int, int, unsigned long, struct run*, double);
+void run_program(char**, const char*, struct run*, double);
+void read_stats(struct run*, struct row*, struct rows*);
+void read_exact(struct run*, struct row*, struct rows*);
+int read_csv(const char*, struct rows*);
+double passes_per_second(struct row*);
+void write_csv(const char*, struct rows*);
+void write_json(const char*, struct rows*);
+void print_summary(struct rows*);
+int compare(struct rows*, struct rows*, double);
+
+int main(int argc, char* argv[]) {
+    char* program_list = DEFAULT_PROGRAMS;
+    char* budget_list = "1";
+    char* seed_list = "1";
+    char* input_dir = DEFAULT_INPUTS;
+    char* csv = "results.csv";
+    char* json = "results.json";
+    char* baseline = NULL;
+    double timeout = 300;
+    double slowdown = 1.5;
+    int i;
+
+    for(i = 1; i < argc; i += 2) {
+        if(i + 1 == argc) {
+            break;
+        } else if(!strcmp(argv[i], "--programs")) {
+            program_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--budgets")) {
+            budget_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--seeds")) {
+            seed_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--inputs")) {
+            input_dir = argv[i + 1];
+        } else if(!strcmp(argv[i], "--csv")) {
+            csv = argv[i + 1];
+        } else if(!strcmp(argv[i], "--json")) {
+            json = argv[i + 1];
+        } else if(!strcmp(argv[i], "--baseline")) {
+            baseline = argv[i + 1];
+        } else if(!strcmp(argv[i], "--timeout")) {
+            timeout = atof(argv[i + 1]);
+        } else if(!strcmp(argv[i], "--slowdown")) {
+            slowdown = atof(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if(i != argc) {
+        printf("Usage %s [--programs <list>] [--budgets <list>] [--seeds <list>] [--inputs <directory>]\n"
+            "    [--csv <file>] [--json <file>] [--baseline <csv file>] [--timeout <seconds per run>] [--slowdown <factor>]\n"
+            "Lists are separated by commas. Programs are %s and %s, or name=path.\n", argv[0], DEFAULT_PROGRAMS, EXACT);
+        return EXIT_FAILURE;
+    }
+
+    char* programs[64];
+    char* budgets[64];
+    char* seeds[64];
+    int program_count = split_list(program_list, programs, 64);
+    int budget_count = split_list(budget_list, budgets, 64);
+    int seed_count = split_list(seed_list, seeds, 64);
+
+    struct dirent** inputs;
+    int input_count = scandir(input_dir, &inputs, is_input, alphasort);
+    if(input_count <= 0) {
+        printf("No inputs found in %s.\n", input_dir);
+        return EXIT_FAILURE;
+    }
+
+    struct rows results = { NULL, 0, 0 };
+    struct row base; // the fields shared by every row of a run
+    struct run run;
+    char path[1024];
+    char* name;
+    char* program;
+    int p, f, b, s, exact;
+
+    for(p = 0; p < program_count; p++) {
+        name = programs[p];
+        program = strchr(name, '=');
+        if(program != NULL) {
+            *program++ = '\0';
+        } else if(!strcmp(name, EXACT)) {
+            program = "../../assignment2/a.out";
+        } else {
+            snprintf(path, sizeof(path), "../%s/a.out", name);
+            program = strdup(path);
+        }
+        exact = !strcmp(name, EXACT);
+
+        for(f = 0; f < input_count; f++) {
+            snprintf(path, sizeof(path), "%s/%s", input_dir, inputs[f]->d_name);
+            for(b = 0; b < (exact ? 1 : budget_count); b++) {
+                for(s = 0; s < (exact ? 1 : seed_count); s++) {
+                    memset(&base, 0, sizeof(base));
+                    snprintf(base.program, sizeof(base.program), "%s", name);
+                    snprintf(base.input, sizeof(base.input), "%s", inputs[f]->d_name);
+                    base.budget = exact ? 0 : atoi(budgets[b]);
+                    base.seed = exact ? 0 : strtoul(seeds[s], NULL, 10);
+
+                    fprintf(stderr, "%s %s budget %d seed %lu\n", name, base.input, base.budget, base.seed);
+                    start_program(program, path, exact, base.budget, base.seed, &run, timeout);
+                    if(run.failed) {
+                        fprintf(stderr, "  failed to run %s\n", program);
+                    } else if(run.timed_out) {
+                        fprintf(stderr, "  timed out after %.0f seconds, later graphs are missing\n", timeout);
+                    }
+
+                    if(!run.failed) {
+                        base.run_seconds = run.seconds;
+                        base.peak_rss_kb = run.peak_rss_kb;
+                        if(exact) {
+                            read_exact(&run, &base, &results);
+                        } else {
+                            read_stats(&run, &base, &results);
+                        }
+                        fclose(run.out);
+                        fclose(run.err);
+                    }
+                }
+            }
+        }
+    }
+
+    write_csv(csv, &results);
+    write_json(json, &results);
+    print_summary(&results);
+
+    if(baseline != NULL) {
+        struct rows expected = { NULL, 0, 0 };
+        if(!read_csv(baseline, &expected)) {
+            printf("Could not read the baseline %s.\n", baseline);
+            return EXIT_FAILURE;
+        }
+        if(compare(&expected, &results, slowdown)) {
+            return EXIT_FAILURE;
+        }
+        printf("No regressions against %s.\n", baseline);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Split a comma separated list, the items pointing into a copy of it.
+// Parameters:
+//   list: the list.
+//   items: space for the items.
+//   max: the most items to keep.
+//
+// Returns the number of items.
+int split_list(const char* list, char** items, int max) {
+    int count = 0;
+    char* item;
+    char* copy = strdup(list);
+    if(copy == NULL) {
+        printf("Out of memory copying %s.\n", list);
+        exit(EXIT_FAILURE);
+    }
+    for(item = strtok(copy, ","); item != NULL && count < max; item = strtok(NULL, ",")) {
+        items[count++] = item;
+    }
+    return count;
+}
+
+// Returns whether a directory entry is an input, a file ending in .txt.
+int is_input(const struct dirent* entry) {
+    size_t length = strlen(entry->d_name);
+    return length > 4 && !strcmp(entry->d_name + length - 4, ".txt");
+}
+
+// Returns a new row at the end of rows.
+struct row* add_row(struct rows* rows) {
+    if(rows->count == rows->capacity) {
+        rows->capacity = rows->capacity ? 2 * rows->capacity : 256;
+        rows->rows = realloc(rows->rows, rows->capacity * sizeof(struct row));
+        if(rows->rows == NULL) {
+            printf("Out of memory allocating %d rows.\n", rows->capacity);
+            exit(EXIT_FAILURE);
+        }
+    }
+    return &rows->rows[rows->count++];
+}
+
+// Run a program on an input with the arguments for its kind.
+// Parameters:
+//   program: the path of the program.
+//   input: the path of the input.
+//   exact: whether the program is the exact solver, which takes no arguments.
+//   budget: the seconds per graph for a heuristic.
+//   seed: the seed for a heuristic.
+//   run: a location to store the run.
+//   timeout: seconds to wait before killing the program.
+void start_program(const char* program, const char* input, int exact, int budget, unsigned long seed,
+        struct run* run, double timeout) {
+    char budget_arg[32];
+    char seed_arg[32];
+    char* args[] = { (char*) program, budget_arg, "0", "--seed", seed_arg, "--stats", NULL };
+
+    snprintf(budget_arg, sizeof(budget_arg), "%d", budget);
+    snprintf(seed_arg, sizeof(seed_arg), "%lu", seed);
+    if(exact) {
+        args[1] = NULL;
+    }
+    run_program(args, input, run, timeout);
+}
+
+// Run a program with an input file as standard input, collecting its output in temporary files.
+// Parameters:
+//   args: the program and its arguments.
+//   input: the path of the input.
+//   run: a location to store the run.
+//   timeout: seconds to wait before killing the program.
+void run_program(char** args, const char* input, struct run* run, double timeout) {
+    struct rusage usage;
+    struct timespec pause = { 0, POLL_INTERVAL * 1e9 };
+    double start = clock_seconds();
+    int status;
+    pid_t pid, done;
+
+    memset(run, 0, sizeof(*run));
+    run->out = tmpfile();
+    run->err = tmpfile();
+    if(run->out == NULL || run->err == NULL) {
+        printf("Could not create temporary files.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if(pid < 0) {
+        printf("Could not start %s.\n", args[0]);
+        exit(EXIT_FAILURE);
+    }
+    if(pid == 0) {
+        int in = open(input, O_RDONLY);
+        if(in < 0) {
+            _exit(127);
+        }
+        dup2(in, STDIN_FILENO);
+        dup2(fileno(run->out), STDOUT_FILENO);
+        dup2(fileno(run->err), STDERR_FILENO);
+        execv(args[0], args);
+        _exit(127);
+    }
+
+    while((done = wait4(pid, &status, WNOHANG, &usage)) == 0) {
+        if(timeout > 0 && clock_seconds() - start > timeout) {
+            kill(pid, SIGKILL);
+            run->timed_out = 1;
+            done = wait4(pid, &status, 0, &usage);
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
+
+    run->seconds = clock_seconds() - start;
+    run->peak_rss_kb = done == pid ? usage.ru_maxrss : -1;
+    run->failed = done != pid || (WIFEXITED(status) && WEXITSTATUS(status) == 127);
+    if(run->failed) {
+        fclose(run->out);
+        fclose(run->err);
+        return;
+    }
+    rewind(run->out);
+    rewind(run->err);
+}
+
+// Collect the statistics a heuristic printed with --stats, one row per graph.
+// Parameters:
+//   run: the finished run.
+//   base: the fields shared by every row of the run.
+//   rows: the rows to add to.
+void read_stats(struct run* run, struct row* base, struct rows* rows) {
+    char line[512];
+    struct row r = *base;
+    while(fgets(line, sizeof(line), run->err) != NULL) {
+        if(sscanf(line, "stats %d %d %d %d %lf %lf %ld %ld", &r.graph, &r.vertices, &r.size, &r.bound,
+                &r.time_to_best, &r.seconds, &r.passes, &r.moves) == 8) {
+            *add_row(rows) = r;
+        }
+    }
+}
+
+// Collect the dominating sets from the exact solver's output: each graph is echoed
+// as its vertex count and adjacency lists, followed by the size and members of the set.
+// Parameters:
+//   run: the finished run.
+//   base: the fields shared by every row of the run.
+//   rows: the rows to add to.
+void read_exact(struct run* run, struct row* base, struct rows* rows) {
+    struct row r = *base;
+    int n, degree, size, v, i, d;
+
+    r.bound = -1;
+    r.time_to_best = -1;
+    r.seconds = -1;
+    for(r.graph = 1; fscanf(run->out, "%d", &n) == 1; r.graph++) {
+        for(v = 0; v < n; v++) {
+            if(fscanf(run->out, "%d", &degree) != 1) {
+                return;
+            }
+            for(i = 0; i < degree; i++) {
+                if(fscanf(run->out, "%d", &d) != 1) {
+                    return;
+                }
+            }
+        }
+        if(fscanf(run->out, "%d", &size) != 1) {
+            return;
+        }
+        for(i = 0; i < size; i++) {
+            if(fscanf(run->out, "%d", &d) != 1) {
+                return;
+            }
+        }
+        r.vertices = n;
+        r.size = size;
+        *add_row(rows) = r;
+    }
+}
+
+// Read rows written by write_csv.
+// Parameters:
+//   file: the path of the CSV file.
+//   rows: the rows to add to.
+//
+// Returns 1 if the file was read and 0 if it could not be opened.
+int read_csv(const char* file, struct rows* rows) {
+    char line[1024];
+    struct row r;
+    FILE* in = fopen(file, "r");
+    if(in == NULL) {
+        return 0;
+    }
+
+    memset(&r, 0, sizeof(r));
+    while(fgets(line, sizeof(line), in) != NULL) {
+        if(sscanf(line, "%63[^,],%255[^,],%d,%lu,%d,%d,%d,%d,%lf,%lf,%ld,%*f,%ld,%lf,%ld", r.program, r.input,
+                &r.budget, &r.seed, &r.graph, &r.vertices, &r.size, &r.bound, &r.time_to_best, &r.seconds,
+                &r.passes, &r.moves, &r.run_seconds, &r.peak_rss_kb) == 14) {
+            *add_row(rows) = r;
+        }
+    }
+
+    fclose(in);
+    return 1;
+}
+
+// Returns the passes per second of a row, 0 if unknown.
+double passes_per_second(struct row* r) {
+    return r->seconds > 0 ? r->passes / r->seconds : 0;
+}
+
+// Write the rows as CSV with a header line.
+// Parameters:
+//   file: the path of the CSV file.
+//   rows: the rows.
+void write_csv(const char* file, struct rows* rows) {
+    struct row* r;
+    int i;
+    FILE* out = fopen(file, "w");
+    if(out == NULL) {
+        printf("Could not write %s.\n", file);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(out, "program,input,budget,seed,graph,vertices,size,bound,time_to_best,seconds,"
+        "passes,passes_per_second,moves,run_seconds,peak_rss_kb\n");
+    for(i = 0; i < rows->count; i++) {
+        r = &rows->rows[i];
+        fprintf(out, "%s,%s,%d,%lu,%d,%d,%d,%d,%.6f,%.6f,%ld,%.1f,%ld,%.3f,%ld\n", r->program, r->input,
+            r->budget, r->seed, r->graph, r->vertices, r->size, r->bound, r->time_to_best, r->seconds,
+            r->passes, passes_per_second(r), r->moves, r->run_seconds, r->peak_rss_kb);
+    }
+    fclose(out);
+}
+
+// Write the rows as a JSON array of objects with the fields of the CSV.
+// Parameters:
+//   file: the path of the JSON file.
+//   rows: the rows.
+void write_json(const char* file, struct rows* rows) {
+    struct row* r;
+    int i;
+    FILE* out = fopen(file, "w");
+    if(out == NULL) {
+        printf("Could not write %s.\n", file);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(out, "[");
+    for(i = 0; i < rows->count; i++) {
+        r = &rows->rows[i];
+        fprintf(out, "%s\n  {\"program\": \"%s\", \"input\": \"%s\", \"budget\": %d, \"seed\": %lu, \"graph\": %d, "
+            "\"vertices\": %d, \"size\": %d, \"bound\": %d, \"time_to_best\": %.6f, \"seconds\": %.6f, "
+            "\"passes\": %ld, \"passes_per_second\": %.1f, \"moves\": %ld, \"run_seconds\": %.3f, \"peak_rss_kb\": %ld}",
+            i ? "," : "", r->program, r->input, r->budget, r->seed, r->graph, r->vertices, r->size, r->bound,
+            r->time_to_best, r->seconds, r->passes, passes_per_second(r), r->moves, r->run_seconds, r->peak_rss_kb);
+    }
+    fprintf(out, "\n]\n");
+    fclose(out);
+}
+
+// Print a line per program and budget: the graphs run, the total size of the sets,
+// the sets that met the lower bound, the mean time to best, the passes per second
+// and the largest peak memory of a run.
+// Parameters:
+//   rows: the rows.
+void print_summary(struct rows* rows) {
+    struct row* r;
+    struct row* first;
+    int i, j, graphs, total, at_bound, timed;
+    long passes, peak;
+    double time_to_best, seconds;
+
+    printf("%-12s %6s %6s %8s %8s %12s %14s %12s\n", "program", "budget", "graphs", "size", "at bound",
+        "time to best", "passes/second", "peak rss kb");
+    for(i = 0; i < rows->count; i++) {
+        first = &rows->rows[i];
+
+        // summarise each program and budget at its first row
+        for(j = 0; j < i; j++) {
+            if(!strcmp(rows->rows[j].program, first->program) && rows->rows[j].budget == first->budget) {
+                break;
+            }
+        }
+        if(j < i) {
+            continue;
+        }
+
+        graphs = total = at_bound = timed = 0;
+        passes = peak = 0;
+        time_to_best = seconds = 0;
+        for(j = i; j < rows->count; j++) {
+            r = &rows->rows[j];
+            if(strcmp(r->program, first->program) || r->budget != first->budget) {
+                continue;
+            }
+            graphs++;
+            total += r->size;
+            at_bound += r->size == r->bound;
+            if(r->time_to_best >= 0) {
+                time_to_best += r->time_to_best;
+                seconds += r->seconds;
+                passes += r->passes;
+                timed++;
+            }
+            if(r->peak_rss_kb > peak) {
+                peak = r->peak_rss_kb;
+            }
+        }
+
+        printf("%-12s %6d %6d %8d %8d %12.4f %14.1f %12ld\n", first->program, first->budget, graphs, total,
+            at_bound, timed ? time_to_best / timed : -1, seconds > 0 ? passes / seconds : 0, peak);
+    }
+}
+
+// Compare the rows of a run against a baseline, printing every regression:
+// a graph that is missing, has a larger set, or took more than slowdown times
+// as long to find its set.
+// Parameters:
+//   expected: the baseline rows.
+//   rows: the rows of this run.
+//   slowdown: the factor by which the time to best may grow.
+//
+// Returns the number of regressions.
+int compare(struct rows* expected, struct rows* rows, double slowdown) {
+    struct row* e;
+    struct row* r;
+    int i, j, ran;
+    int regressions = 0;
+
+    for(i = 0; i < expected->count; i++) {
+        e = &expected->rows[i];
+        r = NULL;
+        ran = 0;
+        for(j = 0; j < rows->count && r == NULL; j++) {
+            if(!strcmp(rows->rows[j].program, e->program) && rows->rows[j].budget == e->budget
+                    && rows->rows[j].seed == e->seed) {
+                ran = 1;
+                if(!strcmp(rows->rows[j].input, e->input) && rows->rows[j].graph == e->graph) {
+                    r = &rows->rows[j];
+                }
+            }
+        }
+
+        // only the programs, budgets and seeds run this time are compared
+        if(r == NULL) {
+            if(ran) {
+                printf("Regression %s %s budget %d seed %lu graph %d: missing\n",
+                    e->program, e->input, e->budget, e->seed, e->graph);
+                regressions++;
+            }
+            continue;
+        }
+
+        if(r->size > e->size) {
+            printf("Regression %s %s budget %d seed %lu graph %d: size %d, baseline %d\n",
+                e->program, e->input, e->budget, e->seed, e->graph, r->size, e->size);
+            regressions++;
+        } else if(r->size == e->size && e->time_to_best >= 0 && r->time_to_best > TIME_SLACK
+                && r->time_to_best > slowdown * e->time_to_best) {
+            printf("Regression %s %s budget %d seed %lu graph %d: time to best %.4f, baseline %.4f\n",
+                e->program, e->input, e->budget, e->seed, e->graph, r->time_to_best, e->time_to_best);
+            regressions++;
+        }
+    }
+
+    return regressions;
+}
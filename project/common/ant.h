@@ -0,0 +1,120 @@
+#ifndef ANT_H
+#define ANT_H
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "graph.h"
+#include "random.h"
+
+// Ant colony orderings for the include/exclude pass, a MAX-MIN ant system.
+// Each vertex has a pheromone level, raised when it is in the best set of a batch of ants
+// and evaporating otherwise. An ant orders the vertices at random, biased by the weight
+// pheromone times closed neighbourhood size: the pass leaves the early vertices out and
+// puts late ones in the set, so heavy vertices are placed late.
+//
+// An ordering is drawn in one go as in Efraimidis and Spirakis' weighted sampling: each
+// vertex gets the key -ln(U) / weight for a uniform U and the vertices are sorted by key,
+// largest first. Pheromone is kept between PHEROMONE_MIN and PHEROMONE_MAX so no vertex is
+// ever certain to be placed early or late, which keeps the colony from stagnating.
+
+// Colony parameters.
+// ANTS: orderings in a batch, the best of which lays pheromone.
+// EVAPORATION: fraction of pheromone lost after each batch.
+// PHEROMONE_MIN, PHEROMONE_MAX: bounds on a vertex's pheromone, which starts at the maximum.
+#define ANTS 10
+#define EVAPORATION 0.1
+#define PHEROMONE_MIN 0.02
+#define PHEROMONE_MAX 1.0
+
+// A vertex and its sort key in an ant's ordering.
+struct ant_key {
+    double key;
+    int vertex;
+};
+
+struct colony {
+    int vertex_count;
+    double* pheromone;
+    double* weight; // pheromone times closed neighbourhood size
+    int* coverage; // closed neighbourhood size
+    struct ant_key* keys;
+};
+
+void colony_init(struct colony*, struct graph*, struct arena*);
+void colony_order(struct colony*, int*);
+void colony_update(struct colony*, int*);
+int compare_key(const void*, const void*);
+
+// Set up the colony for a graph, with the same pheromone on every vertex.
+// Parameters:
+//   c: the colony to set up.
+//   G: the graph.
+//   arena: the arena to allocate the buffers from.
+void colony_init(struct colony* c, struct graph* G, struct arena* arena) {
+    int n = G->vertex_count;
+    int v;
+
+    c->vertex_count = n;
+    c->pheromone = arena_alloc(arena, n * sizeof(double));
+    c->weight = arena_alloc(arena, n * sizeof(double));
+    c->coverage = arena_alloc(arena, n * sizeof(int));
+    c->keys = arena_alloc(arena, n * sizeof(struct ant_key));
+    for(v = 0; v < n; v++) {
+        c->coverage[v] = graph_degree(G, v) + 1;
+        c->pheromone[v] = PHEROMONE_MAX;
+        c->weight[v] = PHEROMONE_MAX * c->coverage[v];
+    }
+}
+
+// Make an ant's ordering, heavy vertices tending to come last.
+// Parameters:
+//   c: the colony, set up with colony_init.
+//   p: a location to store the ordering.
+void colony_order(struct colony* c, int* p) {
+    int n = c->vertex_count;
+    int v;
+
+    for(v = 0; v < n; v++) {
+        // 53 random bits, plus a half so the logarithm is finite
+        c->keys[v].key = -log(((next_random() >> 11) + 0.5) * 0x1.0p-53) / c->weight[v];
+        c->keys[v].vertex = v;
+    }
+    qsort(c->keys, n, sizeof(struct ant_key), compare_key);
+    for(v = 0; v < n; v++) {
+        p[v] = c->keys[v].vertex;
+    }
+}
+
+// Evaporate the pheromone and lay more on the members of a batch's best set.
+// Parameters:
+//   c: the colony.
+//   dom: the best dominating set of the batch.
+void colony_update(struct colony* c, int* dom) {
+    int n = c->vertex_count;
+    double level;
+    int v;
+
+    for(v = 0; v < n; v++) {
+        level = (1 - EVAPORATION) * c->pheromone[v];
+        if(IS_ELEMENT(dom, v)) {
+            level += EVAPORATION * PHEROMONE_MAX;
+        }
+        if(level < PHEROMONE_MIN) {
+            level = PHEROMONE_MIN;
+        }
+        c->pheromone[v] = level;
+        c->weight[v] = level * c->coverage[v];
+    }
+}
+
+// Sort keys from largest to smallest, for qsort.
+int compare_key(const void* a, const void* b) {
+    double x = ((const struct ant_key*) a)->key;
+    double y = ((const struct ant_key*) b)->key;
+    return (x < y) - (x > y);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Storage for the graph being solved and everything sized by it.
+// Allocation takes the next free bytes of a block and nothing is freed individually:
+// arena_reset frees everything at once before the next graph. When a block is full
+// another is chained on, and the next reset replaces them all with one block as large
+// as the most ever used, so after the first few graphs the arena stops calling malloc.
+//
+// Allocations are aligned to cache lines. The arena is not thread safe, threads are
+// given their storage before they start.
+
+#define CACHE_LINE 64
+// Bytes in the first block of an arena.
+#define ARENA_FIRST_BLOCK 65536
+
+struct arena_block {
+    struct arena_block* next;
+    size_t size;
+    size_t used;
+    char* data;
+};
+
+// If set, running out of memory jumps here with 1 instead of exiting.
+// Each thread has its own, so a library call can recover from it, see project/lib.
+static _Thread_local jmp_buf* arena_out_of_memory;
+
+struct arena {
+    struct arena_block* block; // the block being allocated from, then the older blocks
+    size_t total; // bytes allocated since the last reset
+    size_t most; // the largest total seen
+};
+
+void arena_init(struct arena*);
+void arena_reset(struct arena*);
+void* arena_alloc(struct arena*, size_t);
+void* arena_zalloc(struct arena*, size_t);
+void arena_free(struct arena*);
+struct arena_block* arena_new_block(size_t);
+
+// Set up an empty arena.
+void arena_init(struct arena* arena) {
+    arena->block = NULL;
+    arena->total = 0;
+    arena->most = 0;
+}
+
+// Free everything allocated from the arena, keeping one block for the next graph.
+void arena_reset(struct arena* arena) {
+    if(arena->total > arena->most) {
+        arena->most = arena->total;
+    }
+    arena->total = 0;
+
+    if(arena->block != NULL && arena->block->next == NULL) {
+        arena->block->used = 0;
+        return;
+    }
+
+    // replace the chain with one block big enough for everything so far
+    arena_free(arena);
+    if(arena->most) {
+        arena->block = arena_new_block(arena->most);
+    }
+}
+
+// Allocate from the arena, exits if out of memory.
+// Parameters:
+//   arena: the arena.
+//   bytes: the number of bytes needed.
+//
+// Returns the cache line aligned storage.
+void* arena_alloc(struct arena* arena, size_t bytes) {
+    struct arena_block* block = arena->block;
+
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    if(block == NULL || block->size - block->used < bytes) {
+        // at least double so a graph needs few blocks
+        size_t size = block == NULL ? ARENA_FIRST_BLOCK : block->size * 2;
+        block = arena_new_block(size > bytes ? size : bytes);
+        block->next = arena->block;
+        arena->block = block;
+    }
+
+    void* p = block->data + block->used;
+    block->used += bytes;
+    arena->total += bytes;
+    return p;
+}
+
+// Allocate zeroed storage from the arena, exits if out of memory.
+void* arena_zalloc(struct arena* arena, size_t bytes) {
+    return memset(arena_alloc(arena, bytes), 0, bytes);
+}
+
+// Free all of the arena's blocks.
+void arena_free(struct arena* arena) {
+    struct arena_block* block;
+    while(arena->block != NULL) {
+        block = arena->block;
+        arena->block = block->next;
+        free(block->data);
+        free(block);
+    }
+}
+
+// Allocate a block, exits if out of memory unless arena_out_of_memory is set.
+struct arena_block* arena_new_block(size_t size) {
+    struct arena_block* block = malloc(sizeof(struct arena_block));
+    if(block == NULL || (block->data = aligned_alloc(CACHE_LINE, size)) == NULL) {
+        if(arena_out_of_memory != NULL) {
+            free(block);
+            longjmp(*arena_out_of_memory, 1);
+        }
+        printf("Out of memory allocating %zu bytes.\n", size);
+        exit(EXIT_FAILURE);
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef BFS_H
+#define BFS_H
+
+#include "arena.h"
+#include "bitset.h"
+#include "random.h"
+
+// Breadth first orderings of the vertices for the include/exclude pass.
+// Each ordering starts from a random root, visits each vertex's neighbours in random
+// order and starts again from a new random root whenever a component is finished,
+// so every vertex is placed. An ordering takes O(n + m) time and reuses the buffers
+// in struct bfs, which only need setting up once per graph.
+
+struct bfs {
+    int vertex_count;
+    int* start; // closed neighbourhood lists, see closed_neighbourhoods
+    int* nbr;
+    int* visited; // the ordering that last visited each vertex
+    int pass; // the number of the current ordering
+    int* roots; // the vertices in the order they are tried as roots
+};
+
+void bfs_init(struct bfs*, int, int*, int*, struct arena*);
+void bfs_order(struct bfs*, int*);
+
+// Set up the orderings for a graph.
+// Parameters:
+//   b: the state to set up.
+//   vertex_count: the total number of vertices in the graph.
+//   start: the closed neighbourhood list offsets, kept by the caller.
+//   nbr: the closed neighbourhood lists, kept by the caller.
+//   arena: the arena to allocate the buffers from.
+void bfs_init(struct bfs* b, int vertex_count, int* start, int* nbr, struct arena* arena) {
+    int v;
+
+    b->vertex_count = vertex_count;
+    b->start = start;
+    b->nbr = nbr;
+    b->visited = arena_alloc(arena, vertex_count * sizeof(int));
+    b->roots = arena_alloc(arena, vertex_count * sizeof(int));
+    b->pass = 0;
+    for(v = 0; v < vertex_count; v++) {
+        b->visited[v] = 0;
+        b->roots[v] = v;
+    }
+}
+
+// Make a new random breadth first ordering.
+// Parameters:
+//   b: the state, set up with bfs_init.
+//   p: a location to store the ordering.
+void bfs_order(struct bfs* b, int* p) {
+    int n = b->vertex_count;
+    int head, tail, first, r, i, u, v;
+
+    // a new pass number marks every vertex unvisited without clearing visited
+    b->pass++;
+    shuffle(n, b->roots);
+
+    head = 0;
+    tail = 0;
+    r = 0;
+    while(tail < n) {
+        if(head == tail) {
+            // the component is finished, start the next from the first unvisited root
+            while(b->visited[b->roots[r]] == b->pass) {
+                r++;
+            }
+            b->visited[b->roots[r]] = b->pass;
+            p[tail++] = b->roots[r];
+        }
+
+        u = p[head++];
+        first = tail;
+        // the first vertex of a closed neighbourhood is u itself
+        for(i = b->start[u] + 1; i < b->start[u + 1]; i++) {
+            v = b->nbr[i];
+            if(b->visited[v] != b->pass) {
+                b->visited[v] = b->pass;
+                p[tail++] = v;
+            }
+        }
+        shuffle(tail - first, p + first);
+    }
+}
+
+#endif
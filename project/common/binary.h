@@ -0,0 +1,274 @@
+#ifndef BINARY_H
+#define BINARY_H
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "graph.h"
+#include "input.h"
+
+// A binary format for batches of graphs, written by project/convert.
+//
+// The file starts with a struct binary_header. Each graph is then a struct binary_graph
+// followed by its vertex_count + 1 list offsets and its neighbour lists: the compressed
+// sparse rows of a sparse struct graph. Fields are little endian and each array is
+// padded to a multiple of 8 bytes, so a mapped file is used in place, without parsing
+// or copying.
+//
+// The checksum covers the offsets and the lists and is always checked. If the header
+// has BINARY_VALIDATED set every graph passed check_graph when the file was written,
+// so the graphs are not checked again.
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The binary graph format is read in place and needs a little endian machine."
+#endif
+
+#define BINARY_MAGIC "DSGB"
+#define BINARY_VERSION 1
+#define BINARY_VALIDATED 1
+#define BINARY_CHECKSUM_START 0xcbf29ce484222325
+
+struct binary_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct binary_graph {
+    int32_t vertex_count;
+    uint32_t reserved;
+    uint64_t entries; // total length of the neighbour lists
+    uint64_t checksum;
+};
+
+// Whether standard input is in the binary format, found on the first call to binary_input.
+static struct {
+    int checked;
+    int binary;
+    uint32_t flags;
+} binary;
+
+int binary_input();
+int read_binary_graph(struct graph*, struct arena*, int);
+const void* binary_take(size_t, struct arena*, int);
+void check_binary_lists(struct graph*, int*, size_t, int);
+void binary_error(const char*, int);
+size_t binary_padded(size_t);
+uint64_t binary_checksum(const int*, size_t, uint64_t);
+void write_binary_header(FILE*, uint32_t);
+void write_binary_graph(FILE*, struct graph*, struct arena*);
+
+// Find out if standard input is in the binary format, reading its header if it is.
+//
+// Returns 1 for binary input and 0 for text.
+int binary_input() {
+    struct binary_header space;
+    const struct binary_header* header;
+
+    if(binary.checked) {
+        return binary.binary;
+    }
+
+    binary.checked = 1;
+    if(input_available(4) == 4 && !memcmp(input.data + input.pos, BINARY_MAGIC, 4)) {
+        binary.binary = 1;
+        header = input_take(sizeof(struct binary_header), &space);
+        if(header == NULL || header->version != BINARY_VERSION) {
+            printf("Improper graph format, unsupported binary graph file.\n");
+            exit(EXIT_FAILURE);
+        }
+        binary.flags = header->flags;
+    }
+
+    return binary.binary;
+}
+
+// Reads a graph in the binary format from standard in.
+// Parameters:
+//   G: a location to store the graph.
+//   arena: the arena to allocate the graph from.
+//   graph_num: the current graph number for error logging.
+//
+// Returns 1 if a graph was successfully read and 0 at the end of the input.
+// Exits if the graph is not valid.
+int read_binary_graph(struct graph* G, struct arena* arena, int graph_num) {
+    struct binary_graph space;
+    const struct binary_graph* header;
+    int* start;
+    int* nbr;
+    int n;
+    size_t entries;
+
+    G->validated = 0;
+    if(!input_available(1)) {
+        return 0;
+    }
+
+    header = input_take(sizeof(struct binary_graph), &space);
+    if(header == NULL) {
+        binary_error("truncated graph", graph_num);
+    }
+    n = header->vertex_count;
+    check_vertex_count(n, graph_num);
+    if(header->entries > INT_MAX) {
+        binary_error("too many edges", graph_num);
+    }
+    entries = header->entries;
+
+    start = (int*) binary_take(binary_padded(n + 1), arena, graph_num);
+    nbr = (int*) binary_take(binary_padded(entries), arena, graph_num);
+    if(binary_checksum(nbr, entries, binary_checksum(start, n + 1, BINARY_CHECKSUM_START)) != header->checksum) {
+        binary_error("checksum mismatch", graph_num);
+    }
+
+    G->vertex_count = n;
+    G->start = start;
+    if(!(binary.flags & BINARY_VALIDATED)) {
+        check_binary_lists(G, nbr, entries, graph_num);
+    }
+    store_graph(G, arena, nbr, entries, 1);
+    G->validated = (binary.flags & BINARY_VALIDATED) != 0;
+
+    return 1;
+}
+
+// Take an array of a binary graph from the input, exits if the input ends first.
+// Parameters:
+//   bytes: the size of the array.
+//   arena: the arena to copy the array to unless the input is mapped.
+//   graph_num: the current graph number for error logging.
+//
+// Returns the array.
+const void* binary_take(size_t bytes, struct arena* arena, int graph_num) {
+    const void* taken = input_take(bytes, input.mapped ? NULL : arena_alloc(arena, bytes));
+    if(taken == NULL) {
+        binary_error("truncated graph", graph_num);
+    }
+    return taken;
+}
+
+// Checks the lists of a binary graph that was not validated when it was written.
+// Symmetry and loops are left to check_graph.
+// Parameters:
+//   G: the graph, with vertex_count and start set.
+//   nbr: the lists.
+//   entries: the total length of the lists.
+//   graph_num: the current graph number for error logging.
+//
+// Exits if the lists are invalid.
+void check_binary_lists(struct graph* G, int* nbr, size_t entries, int graph_num) {
+    int n = G->vertex_count;
+    int v, i;
+
+    if(G->start[0] != 0 || G->start[n] != (int) entries) {
+        binary_error("list offsets do not match the edge count", graph_num);
+    }
+
+    // the offsets first, so the lists are only read within nbr
+    for(v = 0; v < n; v++) {
+        check_degree(G->start[v + 1] - G->start[v], n, graph_num);
+    }
+
+    for(v = 0; v < n; v++) {
+        for(i = G->start[v]; i < G->start[v + 1]; i++) {
+            check_vertex(nbr[i], n, graph_num);
+            if(i == G->start[v] || nbr[i] > nbr[i - 1]) {
+                continue;
+            }
+
+            if(nbr[i] == nbr[i - 1]) {
+                bad_graph_begin(graph_num);
+                printf("*** Error- graph is not simple, multiple edges between node %5d and node %5d\n", v, nbr[i]);
+                printf("Graph   %5d: BAD GRAPH\n", graph_num);
+                exit(EXIT_FAILURE);
+            }
+            binary_error("neighbours are not in increasing order", graph_num);
+        }
+    }
+}
+
+// Report an invalid binary graph and exit.
+// Parameters:
+//   problem: what is wrong with the graph.
+//   graph_num: the current graph number for error logging.
+void binary_error(const char* problem, int graph_num) {
+    bad_graph_begin(graph_num);
+    printf("\nImproper graph format, %s.\n", problem);
+    printf("Graph   %5d: BAD GRAPH\n", graph_num);
+    exit(EXIT_FAILURE);
+}
+
+// Returns the bytes taken by an array of count ints padded to a multiple of 8.
+size_t binary_padded(size_t count) {
+    return (count * sizeof(int) + 7) & ~(size_t) 7;
+}
+
+// FNV-1a over 32 bit words.
+// Parameters:
+//   words: the words to add to the checksum.
+//   count: the number of words.
+//   h: the checksum so far, BINARY_CHECKSUM_START to begin.
+//
+// Returns the checksum.
+uint64_t binary_checksum(const int* words, size_t count, uint64_t h) {
+    size_t i;
+    for(i = 0; i < count; i++) {
+        h = (h ^ (uint32_t) words[i]) * 0x100000001b3;
+    }
+    return h;
+}
+
+// Start a binary graph file.
+// Parameters:
+//   out: the file.
+//   flags: BINARY_VALIDATED if every graph written will have passed check_graph.
+void write_binary_header(FILE* out, uint32_t flags) {
+    struct binary_header header = { { 0 }, BINARY_VERSION, flags, 0 };
+    memcpy(header.magic, BINARY_MAGIC, 4);
+    fwrite(&header, sizeof(header), 1, out);
+}
+
+// Write a graph in the binary format.
+// Parameters:
+//   out: the file, started with write_binary_header.
+//   G: the graph.
+//   arena: the arena to build the lists in if G is dense.
+void write_binary_graph(FILE* out, struct graph* G, struct arena* arena) {
+    static const char padding[8];
+    struct binary_graph header = { G->vertex_count, 0, 0, 0 };
+    int n = G->vertex_count;
+    int* start = G->start;
+    int* nbr = G->nbr;
+    int v, u, i, it;
+
+    if(G->dense) {
+        start = arena_alloc(arena, (n + 1) * sizeof(int));
+        start[0] = 0;
+        for(v = 0; v < n; v++) {
+            start[v + 1] = start[v] + graph_degree(G, v);
+        }
+        nbr = arena_alloc(arena, (start[n] + 1) * sizeof(int));
+        i = 0;
+        for(v = 0; v < n; v++) {
+            for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+                nbr[i++] = u;
+            }
+        }
+    }
+
+    header.entries = start[n];
+    header.checksum = binary_checksum(nbr, header.entries, binary_checksum(start, n + 1, BINARY_CHECKSUM_START));
+
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(start, sizeof(int), n + 1, out);
+    fwrite(padding, 1, binary_padded(n + 1) - (n + 1) * sizeof(int), out);
+    fwrite(nbr, sizeof(int), header.entries, out);
+    fwrite(padding, 1, binary_padded(header.entries) - header.entries * sizeof(int), out);
+}
+
+#endif
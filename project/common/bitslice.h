@@ -0,0 +1,164 @@
+#ifndef BITSLICE_H
+#define BITSLICE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "random.h"
+
+// The include/exclude pass of dom_set.h for 64 orderings at once.
+// Bit l of every word belongs to lane l, an independent pass. A vertex's num_choice is
+// kept as bit planes, so one word operation updates the counter in all 64 lanes, and
+// the red vertices are a word per vertex of the lanes that put it in their set.
+//
+// All lanes sweep the vertices in the same order p, so they touch the same counters at
+// each step. Each lane differs by the vertices it holds back: a random bit per vertex and
+// lane picks the first or second of two sweeps through p. Lane l's ordering is then its
+// first sweep vertices in the order of p followed by its second sweep vertices in the
+// order of p, which on its own is a uniformly random ordering when p is, so a batch costs
+// two sweeps of word operations for 64 restarts.
+
+#define LANES 64
+
+struct bitslice {
+    int vertex_count;
+    int* start; // closed neighbourhood lists, see closed_neighbourhoods
+    int* nbr;
+    int planes; // bits in each counter, enough for the largest closed neighbourhood
+    uint64_t* count; // count[v * planes + b] is bit b of num_choice[v] in every lane
+    uint64_t* second; // the lanes colouring v in the second sweep
+    uint64_t* red; // the lanes putting v in their dominating set
+    int size[LANES]; // the size of each lane's dominating set
+};
+
+void bitslice_init(struct bitslice*, int, int*, int*, struct arena*);
+int bitslice_evaluate(struct bitslice*, int*, int*);
+uint64_t lanes_at_one(uint64_t*, int);
+void lanes_decrement(uint64_t*, int, uint64_t);
+
+// Set up the lanes for a graph.
+// Parameters:
+//   s: the state to set up.
+//   vertex_count: the total number of vertices in the graph.
+//   start: the closed neighbourhood list offsets, kept by the caller.
+//   nbr: the closed neighbourhood lists, kept by the caller.
+//   arena: the arena to allocate the counters from.
+void bitslice_init(struct bitslice* s, int vertex_count, int* start, int* nbr, struct arena* arena) {
+    int v, largest = 0;
+
+    s->vertex_count = vertex_count;
+    s->start = start;
+    s->nbr = nbr;
+    for(v = 0; v < vertex_count; v++) {
+        if(start[v + 1] - start[v] > largest) {
+            largest = start[v + 1] - start[v];
+        }
+    }
+    for(s->planes = 1; largest >> s->planes; s->planes++) {
+    }
+
+    s->count = arena_alloc(arena, (size_t) vertex_count * s->planes * sizeof(uint64_t));
+    s->second = arena_alloc(arena, vertex_count * sizeof(uint64_t));
+    s->red = arena_alloc(arena, vertex_count * sizeof(uint64_t));
+}
+
+// Find the dominating sets of 64 orderings made from p and keep the smallest.
+// Parameters:
+//   s: the state, set up with bitslice_init.
+//   p: the order both sweeps colour the vertices in.
+//   dom: a location to store the smallest dominating set.
+//
+// Returns the size of the smallest set, the size of every lane's set is left in s->size.
+int bitslice_evaluate(struct bitslice* s, int* p, int* dom) {
+    int n = s->vertex_count;
+    int planes = s->planes;
+    int* start = s->start;
+    int* nbr = s->nbr;
+    uint64_t lanes, forced, blue, bits;
+    int v, b, i, level, sweep, lane, best;
+
+    // a vertex can be dominated by itself and each of its neighbours, in every lane
+    for(v = 0; v < n; v++) {
+        for(b = 0; b < planes; b++) {
+            s->count[(size_t) v * planes + b] = (start[v + 1] - start[v]) >> b & 1 ? UINT64_MAX : 0;
+        }
+        s->second[v] = next_random();
+        s->red[v] = 0;
+    }
+
+    for(sweep = 0; sweep < 2; sweep++) {
+        for(level = 0; level < n; level++) {
+            v = p[level];
+            lanes = sweep ? s->second[v] : ~s->second[v];
+
+            // red where v is the last choice left for a vertex of its closed neighbourhood
+            forced = 0;
+            for(i = start[v]; i < start[v + 1] && (lanes & ~forced); i++) {
+                forced |= lanes_at_one(s->count + (size_t) nbr[i] * planes, planes);
+            }
+            forced &= lanes;
+            s->red[v] |= forced;
+
+            blue = lanes & ~forced;
+            if(blue) {
+                for(i = start[v]; i < start[v + 1]; i++) {
+                    lanes_decrement(s->count + (size_t) nbr[i] * planes, planes, blue);
+                }
+            }
+        }
+    }
+
+    memset(s->size, 0, sizeof(s->size));
+    for(v = 0; v < n; v++) {
+        for(bits = s->red[v]; bits; bits &= bits - 1) {
+            s->size[__builtin_ctzll(bits)]++;
+        }
+    }
+    best = 0;
+    for(lane = 1; lane < LANES; lane++) {
+        if(s->size[lane] < s->size[best]) {
+            best = lane;
+        }
+    }
+
+    memset(dom, 0, SET_WORDS(n) * sizeof(int));
+    for(v = 0; v < n; v++) {
+        if(s->red[v] >> best & 1) {
+            ADD_ELEMENT(dom, v);
+        }
+    }
+    return s->size[best];
+}
+
+// Returns the lanes in which a counter is 1.
+// Parameters:
+//   count: the bit planes of the counter, lowest first.
+//   planes: the number of planes.
+uint64_t lanes_at_one(uint64_t* count, int planes) {
+    uint64_t one = count[0];
+    int b;
+    for(b = 1; b < planes && one; b++) {
+        one &= ~count[b];
+    }
+    return one;
+}
+
+// Subtract 1 from a counter in some lanes.
+// Parameters:
+//   count: the bit planes of the counter, lowest first.
+//   planes: the number of planes.
+//   lanes: the lanes to subtract in, where the counter is above 0.
+void lanes_decrement(uint64_t* count, int planes, uint64_t lanes) {
+    uint64_t borrow = lanes;
+    uint64_t bit;
+    int b;
+    for(b = 0; b < planes && borrow; b++) {
+        bit = count[b];
+        count[b] = bit ^ borrow;
+        borrow &= ~bit;
+    }
+}
+
+#endif
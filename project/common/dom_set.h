@@ -0,0 +1,292 @@
+#ifndef DOM_SET_H
+#define DOM_SET_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "graph.h"
+#include "small.h"
+
+// The include/exclude pass shared by the heuristics.
+//
+// Its counters take the fewest bytes the largest degree allows, 1, 2 or 4, so more of
+// them stay in cache. On a dense graph with 1 or 2 byte counters, each longword of a
+// neighbourhood row is expanded into vectors of lane masks, and its 32 counters are
+// tested, incremented or decremented with a few vector operations instead of a loop
+// over its elements. The vectors are GCC's generic ones of 16 bytes, which every x86-64
+// and ARMv8 processor has instructions for.
+
+// 16 counters of 1 byte or 8 of 2 bytes, and masks selecting some of them.
+typedef uint8_t counters8 __attribute__((vector_size(16)));
+typedef int8_t lanes8 __attribute__((vector_size(16)));
+typedef uint16_t counters16 __attribute__((vector_size(16)));
+typedef int16_t lanes16 __attribute__((vector_size(16)));
+
+// The elements of a longword whose counters fit in a vector.
+#define CHUNK(width) (16 / (width))
+
+int evaluate(struct graph*, int*, void*, void*, int*);
+ALWAYS_INLINE int evaluate_counters(struct graph*, int*, void*, void*, int*, const int);
+ALWAYS_INLINE unsigned counter_get(void*, int, const int);
+ALWAYS_INLINE void counter_set(void*, int, unsigned, const int);
+ALWAYS_INLINE void lanes_of8(unsigned, lanes8*);
+ALWAYS_INLINE void lanes_of16(unsigned, lanes16*);
+ALWAYS_INLINE int lanes_count(const void*, const int);
+ALWAYS_INLINE int row_any_one(void*, int*, int, const int);
+ALWAYS_INLINE int row_add(void*, int*, int, int, const int);
+
+// Find the dominating set an ordering produces.
+// This is the include/exclude pass from Wendy Myrvold's slides in CSC 425, without the
+// backtracking: each vertex of p is left out (blue) unless that leaves a vertex with no
+// way to be dominated, in which case it is put in the dominating set (red).
+// It does not modify G, so several threads can evaluate orderings at once.
+// Small graphs go to the kernels of small.h, which give the same set.
+// Parameters:
+//   G: the graph.
+//   p: the order in which the vertices are coloured.
+//   num_choice: space for n ints, for the number of times each vertex could be dominated.
+//   num_dom: space for n ints, for the number of times each vertex is dominated.
+//   dom: a location to store the dominating set.
+//
+// Returns the size of the dominating set.
+int evaluate(struct graph* G, int* p, void* num_choice, void* num_dom, int* dom) {
+    if(G->closed != NULL) {
+        return small_evaluate(G, p, dom);
+    }
+
+    // a counter never goes above the size of a closed neighbourhood
+    if(G->max_degree < UINT8_MAX) {
+        return evaluate_counters(G, p, num_choice, num_dom, dom, 1);
+    }
+    if(G->max_degree < UINT16_MAX) {
+        return evaluate_counters(G, p, num_choice, num_dom, dom, 2);
+    }
+    return evaluate_counters(G, p, num_choice, num_dom, dom, 4);
+}
+
+// evaluate with counters of width bytes.
+ALWAYS_INLINE int evaluate_counters(struct graph* G, int* p, void* num_choice, void* num_dom, int* dom, const int width) {
+    int n = G->vertex_count;
+    // whether rows are done a longword at a time, the vectors cover the whole of the
+    // last longword so there must be room for its counters in the n ints given
+    int vectors = G->dense && width < 4 && 32 * G->m * width <= n * (int) sizeof(int);
+    unsigned count = vectors ? 32 * G->m : n;
+    int i, it, level, u, blue;
+    int size = 0;
+    int n_dom = 0;
+    int* row;
+
+    // a vertex can be dominated by itself and each of its neighbours
+    for(i = 0; i < n; i++) {
+        counter_set(num_choice, i, graph_degree(G, i) + 1, width);
+    }
+    for(; i < (int) count; i++) {
+        counter_set(num_choice, i, 0, width);
+    }
+    memset(num_dom, 0, count * width);
+    memset(dom, 0, G->m * sizeof(int));
+
+    for(level = 0; level < n && n_dom < n; level++) {
+        u = p[level];
+
+        if(vectors) {
+            row = ROW(G, u);
+            blue = counter_get(num_choice, u, width) > 1 && !row_any_one(num_choice, row, G->m, width);
+            if(blue) {
+                counter_set(num_choice, u, counter_get(num_choice, u, width) - 1, width);
+                row_add(num_choice, row, G->m, -1, width);
+            } else {
+                ADD_ELEMENT(dom, u);
+                size++;
+                if(!counter_get(num_dom, u, width)) {
+                    n_dom++;
+                }
+                counter_set(num_dom, u, counter_get(num_dom, u, width) + 1, width);
+                n_dom += row_add(num_dom, row, G->m, 1, width);
+            }
+            continue;
+        }
+
+        blue = counter_get(num_choice, u, width) > 1;
+        for(it = -1; blue && (i = next_neighbour(G, u, &it)) >= 0;) {
+            if(counter_get(num_choice, i, width) == 1) {
+                blue = 0;
+            }
+        }
+
+        if(blue) {
+            counter_set(num_choice, u, counter_get(num_choice, u, width) - 1, width);
+            for(it = -1; (i = next_neighbour(G, u, &it)) >= 0;) {
+                counter_set(num_choice, i, counter_get(num_choice, i, width) - 1, width);
+            }
+        } else {
+            ADD_ELEMENT(dom, u);
+            size++;
+            if(!counter_get(num_dom, u, width)) {
+                n_dom++;
+            }
+            counter_set(num_dom, u, counter_get(num_dom, u, width) + 1, width);
+            for(it = -1; (i = next_neighbour(G, u, &it)) >= 0;) {
+                if(!counter_get(num_dom, i, width)) {
+                    n_dom++;
+                }
+                counter_set(num_dom, i, counter_get(num_dom, i, width) + 1, width);
+            }
+        }
+    }
+
+    return size;
+}
+
+// Returns counter i of an array of counters of width bytes.
+ALWAYS_INLINE unsigned counter_get(void* counters, int i, const int width) {
+    if(width == 1) {
+        return ((uint8_t*) counters)[i];
+    }
+    if(width == 2) {
+        return ((uint16_t*) counters)[i];
+    }
+    return ((uint32_t*) counters)[i];
+}
+
+// Set counter i of an array of counters of width bytes.
+ALWAYS_INLINE void counter_set(void* counters, int i, unsigned value, const int width) {
+    if(width == 1) {
+        ((uint8_t*) counters)[i] = value;
+    } else if(width == 2) {
+        ((uint16_t*) counters)[i] = value;
+    } else {
+        ((uint32_t*) counters)[i] = value;
+    }
+}
+
+// Find the lanes of 16 1 byte counters.
+// Parameters:
+//   bits: the elements, highest bit first as in a set, see bitset.h.
+//   lanes: a location to store the lanes, -1 for the elements and 0 for the rest.
+ALWAYS_INLINE void lanes_of8(unsigned bits, lanes8* lanes) {
+    uint64_t bytes[2];
+
+    // the multiply copies a byte of bits to all 8 bytes and the mask keeps a different bit in each
+    bytes[0] = ((bits >> 8) * 0x0101010101010101) & 0x0102040810204080;
+    bytes[1] = ((bits & 0xff) * 0x0101010101010101) & 0x0102040810204080;
+    memcpy(lanes, bytes, sizeof(*lanes));
+    *lanes = *lanes != 0;
+}
+
+// Find the lanes of 8 2 byte counters.
+// Parameters:
+//   bits: the elements, highest bit first as in a set.
+//   lanes: a location to store the lanes, -1 for the elements and 0 for the rest.
+ALWAYS_INLINE void lanes_of16(unsigned bits, lanes16* lanes) {
+    const counters16 bit = { 0x80, 0x40, 0x20, 0x10, 0x8, 0x4, 0x2, 0x1 };
+    *lanes = (bit & (uint16_t) bits) != 0;
+}
+
+// Returns the number of lanes set in a vector of lanes of width bytes, 1 or 2.
+// A multiply adds the low bit of every lane of a 64 bit word into its top lane, which
+// avoids popcount, a library call on targets without the instruction.
+ALWAYS_INLINE int lanes_count(const void* lanes, const int width) {
+    const uint64_t low = width == 1 ? 0x0101010101010101 : 0x0001000100010001;
+    uint64_t words[2];
+
+    memcpy(words, lanes, sizeof(words));
+    return (((words[0] & low) * low) >> (64 - 8 * width)) + (((words[1] & low) * low) >> (64 - 8 * width));
+}
+
+// Returns non-zero if any counter of the elements of a set is 1.
+// Parameters:
+//   counters: 32 * m counters of width bytes, 1 or 2.
+//   set: the set, m longwords.
+//   m: the number of longwords.
+//   width: the bytes in a counter.
+ALWAYS_INLINE int row_any_one(void* counters, int* set, int m, const int width) {
+    const int chunk = CHUNK(width);
+    counters8 c8;
+    counters16 c16;
+    lanes8 l8;
+    lanes16 l16;
+    unsigned bits;
+    int k, c;
+
+    for(k = 0; k < m; k++) {
+        for(c = 0; c < 32 / chunk && set[k]; c++) {
+            bits = (unsigned) set[k] >> (32 - chunk * (c + 1)) & ((1u << chunk) - 1);
+            if(!bits) {
+                continue;
+            }
+            if(width == 1) {
+                memcpy(&c8, (uint8_t*) counters + 32 * k + chunk * c, sizeof(c8));
+                lanes_of8(bits, &l8);
+                l8 &= c8 == 1;
+                if(lanes_count(&l8, 1)) {
+                    return 1;
+                }
+            } else {
+                memcpy(&c16, (uint16_t*) counters + 32 * k + chunk * c, sizeof(c16));
+                lanes_of16(bits, &l16);
+                l16 &= c16 == 1;
+                if(lanes_count(&l16, 2)) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Add 1 or -1 to the counters of the elements of a set.
+// Parameters:
+//   counters: 32 * m counters of width bytes, 1 or 2.
+//   set: the set, m longwords.
+//   m: the number of longwords.
+//   delta: 1 or -1.
+//   width: the bytes in a counter.
+//
+// Returns the number of counters that were 0, which is only counted when adding.
+ALWAYS_INLINE int row_add(void* counters, int* set, int m, int delta, const int width) {
+    const int chunk = CHUNK(width);
+    counters8 c8;
+    counters16 c16;
+    lanes8 l8, zero8;
+    lanes16 l16, zero16;
+    unsigned bits;
+    int k, c, was_zero = 0;
+
+    for(k = 0; k < m; k++) {
+        for(c = 0; c < 32 / chunk && set[k]; c++) {
+            bits = (unsigned) set[k] >> (32 - chunk * (c + 1)) & ((1u << chunk) - 1);
+            if(!bits) {
+                continue;
+            }
+            // a lane mask is -1 where selected, so subtracting it adds 1
+            if(width == 1) {
+                memcpy(&c8, (uint8_t*) counters + 32 * k + chunk * c, sizeof(c8));
+                lanes_of8(bits, &l8);
+                if(delta > 0) {
+                    zero8 = (c8 == 0) & l8;
+                    was_zero += lanes_count(&zero8, 1);
+                    c8 -= (counters8) l8;
+                } else {
+                    c8 += (counters8) l8;
+                }
+                memcpy((uint8_t*) counters + 32 * k + chunk * c, &c8, sizeof(c8));
+            } else {
+                memcpy(&c16, (uint16_t*) counters + 32 * k + chunk * c, sizeof(c16));
+                lanes_of16(bits, &l16);
+                if(delta > 0) {
+                    zero16 = (c16 == 0) & l16;
+                    was_zero += lanes_count(&zero16, 2);
+                    c16 -= (counters16) l16;
+                } else {
+                    c16 += (counters16) l16;
+                }
+                memcpy((uint16_t*) counters + 32 * k + chunk * c, &c16, sizeof(c16));
+            }
+        }
+    }
+    return was_zero;
+}
+
+#endif
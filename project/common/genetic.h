@@ -0,0 +1,164 @@
+#ifndef GENETIC_H
+#define GENETIC_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "random.h"
+
+// A genetic algorithm over vertex orderings for the include/exclude pass.
+// Each generation keeps its best orderings unchanged, fills most of the rest with
+// children of parents picked by tournament, and replaces the worst with fresh random
+// orderings. The caller evaluates the individuals, so project/custom can share a
+// generation between threads while the portfolio evaluates one on a single thread.
+
+// Genetic algorithm parameters.
+// POP_SIZE: number of orderings kept in each generation.
+// ELITE: number of best orderings copied unchanged into the next generation.
+// IMMIGRANTS: number of fresh random orderings replacing the worst each generation.
+// TOURNAMENT: number of orderings competing to be chosen as a parent.
+// MUTATION_RATE: percent chance that a child has some of its positions swapped.
+#define POP_SIZE 32
+#define ELITE 2
+#define IMMIGRANTS 2
+#define TOURNAMENT 3
+#define MUTATION_RATE 30
+
+// An ordering of the vertices and the dominating set it produces.
+struct individual {
+    int* p; // vertex ordering fed to the include/exclude pass
+    int* dom; // dominating set produced by p
+    int size; // size of dom, the fitness (smaller is better)
+};
+
+void first_generation(int, struct individual*);
+void next_generation(int, int, struct individual*, struct individual*, int*);
+int compare_fitness(const void*, const void*);
+int tournament();
+void order_crossover(int, int*, int*, int*, int*);
+void mutate(int, int*);
+
+// Fill a generation with random orderings.
+// Parameters:
+//   vertex_count: the length of the orderings.
+//   generation: the POP_SIZE individuals.
+void first_generation(int vertex_count, struct individual* generation) {
+    int i, j;
+    for(i = 0; i < POP_SIZE; i++) {
+        for(j = 0; j < vertex_count; j++) {
+            generation[i].p[j] = j;
+        }
+        shuffle(vertex_count, generation[i].p);
+    }
+}
+
+// Breed the orderings of the next generation. Only the elite are evaluated already.
+// Parameters:
+//   vertex_count: the length of the orderings.
+//   m: the longwords in a set of vertices.
+//   generation: the POP_SIZE individuals, sorted by compare_fitness.
+//   next: a location to store the next POP_SIZE individuals.
+//   used: space for a set of vertex_count vertices, for order_crossover.
+void next_generation(int vertex_count, int m, struct individual* generation, struct individual* next, int* used) {
+    int i;
+
+    // the best orderings survive unchanged, copied as every individual has its own storage
+    for(i = 0; i < ELITE; i++) {
+        memcpy(next[i].p, generation[i].p, vertex_count * sizeof(int));
+        memcpy(next[i].dom, generation[i].dom, m * sizeof(int));
+        next[i].size = generation[i].size;
+    }
+
+    for(; i < POP_SIZE - IMMIGRANTS; i++) {
+        order_crossover(vertex_count, generation[tournament()].p,
+            generation[tournament()].p, next[i].p, used);
+        mutate(vertex_count, next[i].p);
+    }
+
+    // fresh orderings keep the population from converging on one solution
+    for(; i < POP_SIZE; i++) {
+        memcpy(next[i].p, generation[0].p, vertex_count * sizeof(int));
+        shuffle(vertex_count, next[i].p);
+    }
+}
+
+// qsort comparison putting the smallest dominating sets first.
+int compare_fitness(const void* a, const void* b) {
+    return ((const struct individual*) a)->size - ((const struct individual*) b)->size;
+}
+
+// Pick a parent by tournament selection, among a generation of POP_SIZE individuals
+// sorted by fitness.
+//
+// Returns the index of the parent.
+int tournament() {
+    // the generation is sorted so the smallest index is the fittest
+    int i, r;
+    int best = POP_SIZE - 1;
+    for(i = 0; i < TOURNAMENT; i++) {
+        r = random_at_most(POP_SIZE - 1);
+        if(r < best) {
+            best = r;
+        }
+    }
+    return best;
+}
+
+// Order crossover: the child keeps a random slice of parent a in place,
+// and the remaining vertices in the order they appear in parent b.
+// Parameters:
+//   vertex_count: the length of the orderings.
+//   a: the first parent.
+//   b: the second parent.
+//   child: a location to store the child ordering.
+//   used: space for a set of vertex_count vertices.
+void order_crossover(int vertex_count, int* a, int* b, int* child, int* used) {
+    int i, j, t;
+    int start = random_at_most(vertex_count - 1);
+    int end = random_at_most(vertex_count - 1);
+    if(start > end) {
+        t = start;
+        start = end;
+        end = t;
+    }
+
+    memset(used, 0, SET_WORDS(vertex_count) * sizeof(int));
+
+    for(i = start; i <= end; i++) {
+        child[i] = a[i];
+        ADD_ELEMENT(used, a[i]);
+    }
+
+    // fill the rest after the slice, wrapping around
+    j = (end + 1) % vertex_count;
+    for(i = 0; i < vertex_count; i++) {
+        t = b[(end + 1 + i) % vertex_count];
+        if(!IS_ELEMENT(used, t)) {
+            child[j] = t;
+            j = (j + 1) % vertex_count;
+        }
+    }
+}
+
+// Randomly swap a few positions of an ordering.
+// Parameters:
+//   vertex_count: the length of the ordering.
+//   p: the ordering to mutate.
+void mutate(int vertex_count, int* p) {
+    int swaps, i, j, t;
+
+    if(random_at_most(99) >= MUTATION_RATE) {
+        return;
+    }
+
+    for(swaps = random_at_most(2); swaps >= 0; swaps--) {
+        i = random_at_most(vertex_count - 1);
+        j = random_at_most(vertex_count - 1);
+        t = p[i];
+        p[i] = p[j];
+        p[j] = t;
+    }
+}
+
+#endif
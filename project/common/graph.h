@@ -0,0 +1,502 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "input.h"
+#include "output.h"
+
+// Reading, validating and printing graphs in the format specified by assignment 2.
+//
+// A graph is stored in one of two ways, chosen by its density once it has been read:
+// - dense: an adjacency matrix of bit rows. Rows are stride longwords apart: a power of
+//   two for small graphs so rows never straddle a cache line, otherwise a whole number
+//   of cache lines so every row starts on one.
+// - sparse: compressed sparse rows, the sorted neighbours of every vertex one after
+//   another, so memory grows with n + m rather than n^2.
+// The heuristics go through graph_degree, next_neighbour and adjacent, which work for
+// either. Storage is allocated from an arena, so there is no limit on the number of
+// vertices other than memory.
+//
+// Small graphs also keep the closed neighbourhood of every vertex in one, two or four
+// 64 bit words, which the kernels of small.h hold in registers.
+
+// Use the matrix when it is at most this many times the size of the lists: its rows
+// make adjacency tests and set operations cheap, but it grows with n^2.
+#define DENSE_FACTOR 4
+
+// Graphs with at most SMALL_MAX vertices have closed neighbourhood masks, of
+// SMALL_WORDS(n) words each: vertex u is bit u & 63 of word u >> 6.
+#define SMALL_MAX 256
+#define SMALL_WORDS(n) ((n) <= 64 ? 1 : (n) <= 128 ? 2 : 4)
+
+struct graph {
+    int vertex_count;
+    int m; // longwords in a set of vertices
+    int dense; // 1 if the matrix rows are used, 0 if the lists start and nbr are
+    int stride; // longwords from the start of one row to the next
+    int* rows;
+    int* start; // neighbours of v are nbr[start[v]] to nbr[start[v + 1] - 1] in increasing order,
+                // at most INT_MAX entries in all
+    int* nbr;
+    int validated; // 1 if the graph came from a binary file already checked, see binary.h
+    int max_degree; // the largest degree, which sets the counter width of evaluate
+    uint64_t* closed; // closed neighbourhood of v is closed[v * SMALL_WORDS(n)] on, NULL if n > SMALL_MAX
+};
+
+// The neighbourhood of vertex v in dense graph G, a set of G->m longwords.
+#define ROW(G, v) ((G)->rows + (size_t) (v) * (G)->stride)
+
+// Neighbour lists as they are read, before the graph is stored.
+// The buffer is kept from one graph to the next so it only grows a few times.
+static int* read_nbr;
+static size_t read_capacity;
+
+// Called before an invalid graph is reported, if set. A reader thread uses it to wait
+// until the graphs before the invalid one are printed, see pipeline.h.
+void (*bad_graph_hook)(int);
+
+void bad_graph_begin(int);
+void check_int_input(int*, int);
+int read_graph(struct graph*, struct arena*, int);
+int row_stride(int);
+void check_vertex_count(int, int);
+size_t read_vertex(int, int, size_t, int*, int);
+void check_degree(int, int, int);
+void check_vertex(int, int, int);
+void sort_neighbours(int*, int);
+void store_graph(struct graph*, struct arena*, int*, size_t, int);
+uint64_t* small_masks(int, int*, int*, struct arena*);
+int graph_degree(struct graph*, int);
+int next_neighbour(struct graph*, int, int*);
+int adjacent(struct graph*, int, int);
+void check_graph(struct graph*, int);
+void print_graph(struct graph*);
+void print_dom_set(int, int, int*);
+void closed_neighbourhoods(struct graph*, struct arena*, int**, int**);
+int binary_input();
+int read_binary_graph(struct graph*, struct arena*, int);
+
+// Start reporting an invalid graph, which is followed by exiting.
+// Parameters:
+//   graph_num: the number of the invalid graph.
+void bad_graph_begin(int graph_num) {
+    if(bad_graph_hook != NULL) {
+        bad_graph_hook(graph_num);
+    }
+}
+
+// Utility to check if input_int failed to read a value.
+// Parameters:
+//   d: space to read the next integer into.
+//   graph_num: the current graph number for error logging.
+//
+// Exits if a value is not read as this implies an invalid graph.
+void check_int_input(int* d, int graph_num) {
+    if(!input_int(d)) {
+        bad_graph_begin(graph_num);
+        printf("\nImproper graph format, failed to read value.\n");
+        printf("Graph   %5d: BAD GRAPH\n", graph_num);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Reads a graph from standard in, in the text format or the binary format of binary.h.
+// Parameters:
+//   G: a location to store the graph.
+//   arena: the arena to allocate the graph from.
+//   graph_num: the current graph number for error logging.
+//
+// Returns 1 if a graph was successfully read and 0 otherwise.
+int read_graph(struct graph* G, struct arena* arena, int graph_num) {
+    if(binary_input()) {
+        return read_binary_graph(G, arena, graph_num);
+    }
+
+    G->validated = 0;
+    if(!input_int(&G->vertex_count)) {
+        return 0;
+    }
+
+    check_vertex_count(G->vertex_count, graph_num);
+
+    int n = G->vertex_count;
+    int i;
+    size_t entries = 0;
+
+    // the vertex each vertex was last read as a neighbour of, to find multiple edges
+    int* last = arena_alloc(arena, n * sizeof(int));
+    for(i = 0; i < n; i++) {
+        last[i] = -1;
+    }
+
+    G->start = arena_alloc(arena, (n + 1) * sizeof(int));
+    for(i = 0; i < n; i++) {
+        G->start[i] = entries;
+        entries = read_vertex(i, n, entries, last, graph_num);
+    }
+    G->start[n] = entries;
+
+    store_graph(G, arena, read_nbr, entries, 0);
+    return 1;
+}
+
+// Returns the number of longwords to leave between rows of m longwords.
+int row_stride(int m) {
+    int line = CACHE_LINE / sizeof(int);
+    int stride = 1;
+
+    if(m >= line) {
+        return (m + line - 1) / line * line;
+    }
+    while(stride < m) {
+        stride *= 2;
+    }
+    return stride;
+}
+
+// Checks if the number of vertices is valid.
+// Parameters:
+//   vertex_count: the vertex_count to check
+//   graph_num: the current graph number for error logging.
+//
+// Exits if graph is not valid.
+void check_vertex_count(int vertex_count, int graph_num) {
+    if(vertex_count < 0 ) {
+        bad_graph_begin(graph_num);
+        printf("Improper graph format, negative vertex count\n");
+        printf("Graph   %5d: BAD GRAPH\n", graph_num);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Reads the neighbours of a vertex onto the end of read_nbr.
+// Parameters:
+//   vertex: the current vertex number.
+//   vertex_count: the total vertices in the graph.
+//   entries: the number of neighbours read so far for the graph.
+//   last: the vertex each vertex was last read as a neighbour of.
+//   graph_num: the current graph number for error logging.
+//
+// Returns the number of neighbours read so far including this vertex's.
+// Exits if the graph is not valid
+size_t read_vertex(int vertex, int vertex_count, size_t entries, int* last, int graph_num) {
+    int degree;
+
+    check_int_input(&degree, graph_num);
+    check_degree(degree, vertex_count, graph_num);
+
+    // the list offsets are ints, as in the binary format
+    if(entries + degree > INT_MAX) {
+        bad_graph_begin(graph_num);
+        printf("*** Error- graph too large, more than %d neighbour list entries\n", INT_MAX);
+        printf("Graph   %5d: BAD GRAPH\n", graph_num);
+        exit(EXIT_FAILURE);
+    }
+
+    if(entries + degree > read_capacity) {
+        read_capacity = 2 * (entries + degree);
+        read_nbr = realloc(read_nbr, read_capacity * sizeof(int));
+        if(read_nbr == NULL) {
+            printf("Out of memory allocating %zu bytes.\n", read_capacity * sizeof(int));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    int i, neighbour;
+    int sorted = 1;
+    int* list = read_nbr + entries;
+    for(i = 0; i < degree; i++) {
+        check_int_input(&neighbour, graph_num);
+        check_vertex(neighbour, vertex_count, graph_num);
+        
+        // a multiple-edge (node has multiple edges to the same neighbouring node)
+        if(last[neighbour] == vertex) {
+            bad_graph_begin(graph_num);
+            printf("*** Error- graph is not simple, multiple edges between node %5d and node %5d\n", vertex, neighbour);
+            printf("Graph   %5d: BAD GRAPH\n", graph_num);
+            exit(EXIT_FAILURE);
+        } else {
+            last[neighbour] = vertex;
+            list[i] = neighbour;
+            if(i && neighbour < list[i - 1]) {
+                sorted = 0;
+            }
+        }
+    }
+
+    if(!sorted) {
+        sort_neighbours(list, degree);
+    }
+
+    return entries + degree;
+}
+
+// Checks if the degree of a vertex is valid.
+// Parameters:
+//   degree: the degree of a vertex being checked.
+//   vertex_count: the total number of vertices in the graph.
+//   graph_num: the current graph number for error logging.
+//
+// Exits if the degree is invalid
+void check_degree(int degree, int vertex_count, int graph_num) {
+    int max = vertex_count - 1;
+    if(degree < 0 || degree > max) {
+        bad_graph_begin(graph_num);
+        printf("*** Error- invalid graph, degree %5d is not in the range [0, %5d]\n", degree, vertex_count - 1);
+        printf("Graph   %5d: BAD GRAPH\n", graph_num);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Checks if the value of a vertex is valid.
+// Parameters:
+//   vertex: the vertex number being checked.
+//   vertex_count: the total number of vertices in the graph.
+//   graph_num: the current graph number for error logging.
+//
+// Exits if the vertex is invalid
+void check_vertex(int vertex, int vertex_count, int graph_num) {
+    int max = vertex_count - 1;
+    if(vertex < 0 || vertex > max) {
+        bad_graph_begin(graph_num);
+        printf("*** Error- invalid graph, value %5d is not in the range [0, %5d]\n", vertex, vertex_count - 1);
+        printf("Graph   %5d: BAD GRAPH\n", graph_num);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Sort a neighbour list into increasing order.
+// Parameters:
+//   list: the neighbours.
+//   degree: the length of the list.
+void sort_neighbours(int* list, int degree) {
+    int i, j, v;
+
+    // lists are short and usually sorted already
+    for(i = 1; i < degree; i++) {
+        v = list[i];
+        for(j = i; j > 0 && list[j - 1] > v; j--) {
+            list[j] = list[j - 1];
+        }
+        list[j] = v;
+    }
+}
+
+// Store neighbour lists as a dense or a sparse graph, see DENSE_FACTOR.
+// Parameters:
+//   G: the graph, with vertex_count and start set.
+//   arena: the arena to allocate the graph from.
+//   nbr: the lists.
+//   entries: the total length of the lists.
+//   keep: 1 if nbr lasts as long as the graph so a sparse graph can use it, 0 to copy it.
+void store_graph(struct graph* G, struct arena* arena, int* nbr, size_t entries, int keep) {
+    int n = G->vertex_count;
+    int i, j;
+
+    G->m = SET_WORDS(n);
+    G->stride = row_stride(G->m);
+    G->dense = (double) n * G->stride * sizeof(int) <= DENSE_FACTOR * (double) (n + 1 + entries) * sizeof(int);
+
+    G->closed = n <= SMALL_MAX ? small_masks(n, G->start, nbr, arena) : NULL;
+    G->max_degree = 0;
+    for(i = 0; i < n; i++) {
+        if(G->start[i + 1] - G->start[i] > G->max_degree) {
+            G->max_degree = G->start[i + 1] - G->start[i];
+        }
+    }
+
+    if(!G->dense) {
+        G->rows = NULL;
+        G->nbr = nbr;
+        if(!keep) {
+            G->nbr = arena_alloc(arena, (entries + 1) * sizeof(int));
+            memcpy(G->nbr, nbr, entries * sizeof(int));
+        }
+        return;
+    }
+
+    G->rows = arena_zalloc(arena, (size_t) n * G->stride * sizeof(int));
+    for(i = 0; i < n; i++) {
+        for(j = G->start[i]; j < G->start[i + 1]; j++) {
+            ADD_ELEMENT(ROW(G, i), nbr[j]);
+        }
+    }
+    G->start = NULL;
+    G->nbr = NULL;
+}
+
+// Build the closed neighbourhood masks of a small graph, see SMALL_MAX.
+// Parameters:
+//   n: the number of vertices, at most SMALL_MAX.
+//   start: the list offsets.
+//   nbr: the lists.
+//   arena: the arena to allocate the masks from.
+//
+// Returns the masks, SMALL_WORDS(n) words per vertex.
+uint64_t* small_masks(int n, int* start, int* nbr, struct arena* arena) {
+    int words = SMALL_WORDS(n);
+    uint64_t* closed = arena_zalloc(arena, (size_t) n * words * sizeof(uint64_t));
+    int v, i;
+
+    for(v = 0; v < n; v++) {
+        closed[v * words + (v >> 6)] |= (uint64_t) 1 << (v & 63);
+        for(i = start[v]; i < start[v + 1]; i++) {
+            closed[v * words + (nbr[i] >> 6)] |= (uint64_t) 1 << (nbr[i] & 63);
+        }
+    }
+    return closed;
+}
+
+// Returns the degree of vertex v.
+int graph_degree(struct graph* G, int v) {
+    if(G->dense) {
+        return set_size(G->vertex_count, ROW(G, v));
+    }
+    return G->start[v + 1] - G->start[v];
+}
+
+// Step through the neighbours of a vertex in increasing order:
+//   for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;)
+// Parameters:
+//   G: the graph.
+//   v: the vertex.
+//   it: the position reached, -1 to start.
+//
+// Returns the next neighbour of v or -1 if there are no more.
+int next_neighbour(struct graph* G, int v, int* it) {
+    if(G->dense) {
+        return *it = next_element(ROW(G, v), G->m, *it);
+    }
+
+    int i = G->start[v] + ++*it;
+    return i < G->start[v + 1] ? G->nbr[i] : -1;
+}
+
+// Returns non-zero if u and v are adjacent.
+int adjacent(struct graph* G, int u, int v) {
+    if(G->dense) {
+        return IS_ELEMENT(ROW(G, u), v) != 0;
+    }
+
+    // binary search the sorted neighbours of u
+    int low = G->start[u];
+    int high = G->start[u + 1] - 1;
+    int mid;
+    while(low <= high) {
+        mid = low + (high - low) / 2;
+        if(G->nbr[mid] == v) {
+            return 1;
+        }
+        if(G->nbr[mid] < v) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return 0;
+}
+
+// Checks the validity of a graph (should be simple).
+// A graph from a binary file marked as validated was checked when the file was written.
+// Parameters:
+//   G: the current graph being checked for validity.
+//   graph_num: the current graph number for error logging.
+//
+// Exits if the graph is invalid.
+void check_graph(struct graph* G, int graph_num) {
+    int i, j, it;
+    if(G->validated) {
+        return;
+    }
+    for(i = 0; i < G->vertex_count; i++) {
+        for(it = -1; (j = next_neighbour(G, i, &it)) >= 0;) {
+            if(!adjacent(G, j, i)) {
+                bad_graph_begin(graph_num);
+                printf("*** Error- adjacency matrix is not symmetric: A[%5d][%5d] != A[%5d][%5d]\n", i, j, j, i);
+                printf("Graph   %5d: BAD GRAPH\n", graph_num);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if(adjacent(G, i, i)) {
+            bad_graph_begin(graph_num);
+            printf("*** Error- graph is not simple, loop at node %5d\n", i);
+            printf("Graph   %5d: BAD GRAPH\n", graph_num);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// Prints the graph in an adjacency list format with degree and vertex count.
+// The output is buffered, see output_flush.
+// Parameters:
+//   G: the current graph being printed.
+void print_graph(struct graph* G) {
+    int i, j, it;
+
+    output_int(G->vertex_count, 5);
+    output_char('\n');
+    for (i = 0; i < G->vertex_count; i++) {
+        output_int(graph_degree(G, i), 5);
+        for(it = -1; (j = next_neighbour(G, i, &it)) >= 0;) {
+            output_int(j, 5);
+        }
+        output_char('\n');
+    }
+}
+
+// Print a dominating set.
+// The output is buffered, see output_flush.
+// Parameters:
+//   size: the size of the dominating set.
+//   vertex_count: the total number of vertices in the graph.
+//   dom: the dominating set.
+void print_dom_set(int size, int vertex_count, int* dom) {
+    output_char('\n');
+    output_int(size, 5);
+    output_char('\n');
+    print_set(vertex_count, dom);
+    output_char('\n');
+}
+
+// Build adjacency lists of the closed neighbourhoods of a graph.
+// Parameters:
+//   G: the graph.
+//   arena: the arena to allocate the lists from, exits if out of memory.
+//   start: a location to store the list offsets, the closed neighbourhood of v
+//          is nbr[start[v]] to nbr[start[v + 1] - 1] with v first.
+//   nbr: a location to store the neighbours.
+void closed_neighbourhoods(struct graph* G, struct arena* arena, int** start, int** nbr) {
+    int n = G->vertex_count;
+    int i, j, it;
+    size_t edges;
+
+    edges = 0;
+    for(i = 0; i < n; i++) {
+        edges += graph_degree(G, i) + 1;
+    }
+
+    *start = arena_alloc(arena, (n + 1) * sizeof(int));
+    *nbr = arena_alloc(arena, (edges + 1) * sizeof(int));
+
+    edges = 0;
+    for(i = 0; i < n; i++) {
+        (*start)[i] = edges;
+        (*nbr)[edges++] = i;
+        for(it = -1; (j = next_neighbour(G, i, &it)) >= 0;) {
+            (*nbr)[edges++] = j;
+        }
+    }
+    (*start)[n] = edges;
+}
+
+#include "binary.h"
+
+#endif
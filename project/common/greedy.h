@@ -0,0 +1,164 @@
+#ifndef GREEDY_H
+#define GREEDY_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "random.h"
+
+// Max-coverage greedy: repeatedly add the vertex that dominates the most
+// undominated vertices, breaking ties at random. This is within a factor
+// of ln(n) of a minimum dominating set.
+//
+// The gain of every vertex is kept in a bucket queue: order holds the vertices
+// sorted by gain and bucket g is order[bin[g]] to order[bin[g + 1] - 1].
+// A gain is lowered by swapping the vertex to the front of its bucket and
+// moving the bucket boundary past it, so each pick costs O(deg^2).
+
+struct greedy {
+    int vertex_count;
+    int* start; // closed neighbourhood of v is nbr[start[v]] to nbr[start[v + 1] - 1]
+    int* nbr;
+    int* gain; // number of undominated vertices in the closed neighbourhood
+    int* dominated;
+    int* order; // the vertices sorted by gain
+    int* pos; // index of each vertex in order
+    int* bin; // index in order of the first vertex with each gain, vertex_count + 2 entries
+};
+
+void greedy_init(struct greedy*, int, int*, int*, struct arena*);
+int greedy_dom_set(struct greedy*, int*, int*);
+void greedy_lower(struct greedy*, int);
+void greedy_order(struct greedy*, int*, int, int*);
+
+// Set up the greedy for a graph.
+// Parameters:
+//   g: the greedy state to set up.
+//   vertex_count: the total number of vertices in the graph.
+//   start: the closed neighbourhood list offsets, see closed_neighbourhoods, kept by the caller.
+//   nbr: the closed neighbourhood lists, kept by the caller.
+//   arena: the arena to allocate the buffers from.
+void greedy_init(struct greedy* g, int vertex_count, int* start, int* nbr, struct arena* arena) {
+    g->vertex_count = vertex_count;
+    g->start = start;
+    g->nbr = nbr;
+    g->gain = arena_alloc(arena, vertex_count * sizeof(int));
+    g->dominated = arena_alloc(arena, vertex_count * sizeof(int));
+    g->order = arena_alloc(arena, vertex_count * sizeof(int));
+    g->pos = arena_alloc(arena, vertex_count * sizeof(int));
+    g->bin = arena_alloc(arena, (vertex_count + 2) * sizeof(int));
+}
+
+// Find a dominating set with the max-coverage greedy.
+// Parameters:
+//   g: the greedy state, set up with greedy_init.
+//   picks: a location to store the members in the order they were picked.
+//   dom: a location to store the dominating set.
+//
+// Returns the size of the dominating set.
+int greedy_dom_set(struct greedy* g, int* picks, int* dom) {
+    int n = g->vertex_count;
+    int i, j, v, u, top, size;
+
+    // counting sort the vertices by their starting gain, the closed degree
+    memset(g->bin, 0, (n + 2) * sizeof(int));
+    for(v = 0; v < n; v++) {
+        g->gain[v] = g->start[v + 1] - g->start[v];
+        g->dominated[v] = 0;
+        g->bin[g->gain[v] + 1]++;
+    }
+    for(i = 1; i <= n + 1; i++) {
+        g->bin[i] += g->bin[i - 1];
+    }
+    for(v = 0; v < n; v++) {
+        g->pos[v] = g->bin[g->gain[v]]++;
+        g->order[g->pos[v]] = v;
+    }
+    for(i = n + 1; i > 0; i--) {
+        g->bin[i] = g->bin[i - 1];
+    }
+    g->bin[0] = 0;
+
+    memset(dom, 0, SET_WORDS(n) * sizeof(int));
+    size = 0;
+    top = n;
+    while(1) {
+        // the top bucket runs to the end of order
+        while(top > 0 && g->bin[top] == n) {
+            top--;
+        }
+        if(top == 0) {
+            break;
+        }
+
+        v = g->order[g->bin[top] + random_at_most(n - 1 - g->bin[top])];
+        picks[size++] = v;
+        ADD_ELEMENT(dom, v);
+
+        for(i = g->start[v]; i < g->start[v + 1]; i++) {
+            u = g->nbr[i];
+            if(g->dominated[u]) {
+                continue;
+            }
+
+            g->dominated[u] = 1;
+            for(j = g->start[u]; j < g->start[u + 1]; j++) {
+                greedy_lower(g, g->nbr[j]);
+            }
+        }
+    }
+
+    return size;
+}
+
+// Lower the gain of a vertex by one.
+void greedy_lower(struct greedy* g, int v) {
+    int b = g->gain[v];
+    int first = g->order[g->bin[b]];
+
+    // swap v with the first vertex of its bucket, then shrink the bucket past it
+    g->order[g->pos[v]] = first;
+    g->pos[first] = g->pos[v];
+    g->order[g->bin[b]] = v;
+    g->pos[v] = g->bin[b];
+    g->bin[b]++;
+    g->gain[v]--;
+}
+
+// Turn a greedy set into an ordering for evaluate.
+// The other vertices come first in random order so they are all left out,
+// then the members in reverse pick order so the last picked, which covered the least,
+// are the first to be dropped if they are redundant.
+// Parameters:
+//   g: the greedy state.
+//   picks: the members in the order they were picked.
+//   size: the number of members.
+//   p: a location to store the ordering.
+void greedy_order(struct greedy* g, int* picks, int size, int* p) {
+    int n = g->vertex_count;
+    int i, k;
+
+    // mark the members, reusing dominated as scratch space
+    for(i = 0; i < n; i++) {
+        g->dominated[i] = 0;
+    }
+    for(i = 0; i < size; i++) {
+        g->dominated[picks[i]] = 1;
+    }
+
+    k = 0;
+    for(i = 0; i < n; i++) {
+        if(!g->dominated[i]) {
+            p[k++] = i;
+        }
+    }
+    shuffle(k, p);
+
+    for(i = size - 1; i >= 0; i--) {
+        p[k++] = picks[i];
+    }
+}
+
+#endif
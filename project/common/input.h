@@ -0,0 +1,220 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Reading standard input without scanf.
+// A regular file is memory mapped and parsed in place. Anything else, such as a pipe,
+// is read in large blocks into a buffer. Integers are parsed as scanf("%d") would:
+// leading white space, an optional sign, then decimal digits. Binary input is taken
+// in blocks with input_take, which does not copy a mapped file.
+
+// Bytes read at a time when standard input cannot be mapped.
+#define INPUT_BUFFER (1 << 20)
+
+struct input {
+    int opened;
+    int mapped; // 1 if data is the mapped file, 0 if it is buffer
+    const char* data; // the bytes available to parse
+    size_t size; // number of bytes in data
+    size_t pos; // index in data of the next byte to parse
+    long offset; // offset in standard input of data[0]
+    char* buffer;
+};
+
+// Standard input, opened on first use.
+static struct input input;
+
+void input_open();
+int input_fill();
+int input_byte();
+int input_int(int*);
+int input_peek();
+size_t input_available(size_t);
+const void* input_take(size_t, void*);
+long input_offset();
+
+// Map standard input if it is a regular file, otherwise set up the buffer.
+void input_open() {
+    struct stat st;
+    off_t start = lseek(STDIN_FILENO, 0, SEEK_CUR);
+    void* data;
+
+    input.opened = 1;
+    if(start >= 0 && !fstat(STDIN_FILENO, &st) && S_ISREG(st.st_mode) && st.st_size > start) {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+        if(data != MAP_FAILED) {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            input.mapped = 1;
+            input.data = data;
+            input.size = st.st_size;
+            input.pos = start;
+            input.offset = 0;
+            return;
+        }
+    }
+
+    input.buffer = malloc(INPUT_BUFFER);
+    if(input.buffer == NULL) {
+        printf("Out of memory allocating %d bytes.\n", INPUT_BUFFER);
+        exit(EXIT_FAILURE);
+    }
+    input.data = input.buffer;
+    input.offset = start >= 0 ? start : 0;
+}
+
+// Move the unparsed bytes of a buffered input to the front and read more after them.
+//
+// Returns 0 if nothing more could be read, as at the end of the input.
+int input_fill() {
+    size_t left = input.size - input.pos;
+    ssize_t count;
+
+    if(input.mapped || left == INPUT_BUFFER) {
+        return 0;
+    }
+
+    memmove(input.buffer, input.buffer + input.pos, left);
+    input.offset += input.pos;
+    input.pos = 0;
+    input.size = left;
+    do {
+        count = read(STDIN_FILENO, input.buffer + left, INPUT_BUFFER - left);
+    } while(count < 0 && errno == EINTR);
+    if(count <= 0) {
+        return 0;
+    }
+
+    input.size += count;
+    return 1;
+}
+
+// Returns the next byte without consuming it, or -1 at the end of the input.
+int input_byte() {
+    if(input.pos == input.size && !input_fill()) {
+        return -1;
+    }
+    return (unsigned char) input.data[input.pos];
+}
+
+// Read an integer from standard input.
+// Parameters:
+//   d: space to read the integer into.
+//
+// Returns 1 if an integer was read, 0 at the end of the input or if the next
+// characters are not an integer or it does not fit in an int.
+int input_int(int* d) {
+    long long value = 0;
+    int negative = 0;
+    int digits = 0;
+    int c;
+
+    if(!input.opened) {
+        input_open();
+    }
+
+    while((c = input_byte()) == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+        input.pos++;
+    }
+    if(c == '-' || c == '+') {
+        negative = c == '-';
+        input.pos++;
+    }
+
+    while((c = input_byte()) >= '0' && c <= '9') {
+        if(value <= INT_MAX) {
+            value = value * 10 + c - '0';
+        }
+        digits++;
+        input.pos++;
+    }
+
+    if(!digits || value > (negative ? -(long long) INT_MIN : INT_MAX)) {
+        return 0;
+    }
+    *d = negative ? -value : value;
+    return 1;
+}
+
+// Skip white space and look at the next byte without consuming it.
+//
+// Returns the byte, or -1 at the end of the input.
+int input_peek() {
+    int c;
+
+    if(!input.opened) {
+        input_open();
+    }
+    while((c = input_byte()) == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+        input.pos++;
+    }
+    return c;
+}
+
+// Make up to INPUT_BUFFER bytes available to look at in input.data + input.pos.
+// Parameters:
+//   bytes: the number of bytes wanted.
+//
+// Returns the number available, less than bytes only at the end of the input.
+size_t input_available(size_t bytes) {
+    if(!input.opened) {
+        input_open();
+    }
+    while(input.size - input.pos < bytes && input_fill()) {
+    }
+    return input.size - input.pos < bytes ? input.size - input.pos : bytes;
+}
+
+// Consume the next bytes of the input.
+// Parameters:
+//   bytes: the number of bytes to take.
+//   space: a location to copy them to, used unless the input is mapped.
+//
+// Returns the bytes, in the mapping or in space, or NULL if the input ends first.
+const void* input_take(size_t bytes, void* space) {
+    const char* taken;
+    char* out = space;
+    size_t count;
+
+    if(!input.opened) {
+        input_open();
+    }
+
+    if(input.mapped) {
+        if(input.size - input.pos < bytes) {
+            return NULL;
+        }
+        taken = input.data + input.pos;
+        input.pos += bytes;
+        return taken;
+    }
+
+    while(bytes) {
+        if(input.pos == input.size && !input_fill()) {
+            return NULL;
+        }
+        count = input.size - input.pos < bytes ? input.size - input.pos : bytes;
+        memcpy(out, input.data + input.pos, count);
+        out += count;
+        input.pos += count;
+        bytes -= count;
+    }
+    return space;
+}
+
+// Returns the offset in standard input of the next byte to parse.
+long input_offset() {
+    if(!input.opened) {
+        input_open();
+    }
+    return input.offset + input.pos;
+}
+
+#endif
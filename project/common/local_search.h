@@ -0,0 +1,290 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "graph.h"
+#include "random.h"
+#include "stats.h"
+#include "timer.h"
+
+// Tabu local search that improves a dominating set found by a constructive pass.
+// While the current set dominates every vertex it drops the member whose removal
+// leaves the fewest vertices undominated, otherwise it swaps a member out for a
+// neighbour of an undominated vertex. The dominated counts and the undominated
+// vertices are kept up to date on every move, so a move and the score of a
+// candidate only cost the degree of the vertices involved.
+
+// Fraction of the time limit spent on restarts before the local search takes over.
+#define LS_FRACTION 0.5
+// Number of members sampled when choosing one to remove.
+#define LS_SAMPLE 50
+// Number of moves a removed vertex may not be added back, or an added vertex removed.
+#define LS_TABU 5
+
+// The search allocates from its own arena so threads can search at once.
+struct local_search {
+    struct arena* arena;
+    int vertex_count;
+    int* start; // closed neighbourhood of v is nbr[start[v]] to nbr[start[v + 1] - 1]
+    int* nbr;
+    int* num_dom; // number of members in the closed neighbourhood of each vertex
+    int* members; // the current dominating set
+    int* member_pos; // index of each member in members, -1 for non-members
+    int size;
+    int* undom; // the vertices no member dominates
+    int* undom_pos; // index of each undominated vertex in undom, -1 if dominated
+    int undom_count;
+    long* no_add_until; // move number a removed vertex may be added again
+    long* no_drop_until; // move number an added vertex may be removed again
+};
+
+int local_search(struct graph*, int*, int, double, int, atomic_int*);
+int local_search_in(struct arena*, struct graph*, int*, int, double, int, atomic_int*);
+void ls_build(struct local_search*, struct graph*, struct arena*);
+void ls_add(struct local_search*, int);
+void ls_drop(struct local_search*, int);
+int ls_gain(struct local_search*, int);
+int ls_loss(struct local_search*, int);
+int ls_pick_drop(struct local_search*, long);
+int ls_pick_add(struct local_search*, long);
+
+// Improve a dominating set until the time limit.
+// Parameters:
+//   G: the graph the dominating set is for.
+//   dom: the dominating set to improve, replaced by the best set found.
+//   size: the size of dom.
+//   time_limit: stop when check_timer reaches this many seconds.
+//   bound: stop when a set this small is found, see lower_bound.
+//   shared_best: if not NULL, also stop when another thread lowers this to bound.
+//
+// Returns the size of the best dominating set found.
+int local_search(struct graph* G, int* dom, int size, double time_limit, int bound, atomic_int* shared_best) {
+    struct arena arena;
+    arena_init(&arena);
+    size = local_search_in(&arena, G, dom, size, time_limit, bound, shared_best);
+    arena_free(&arena);
+    return size;
+}
+
+// local_search with the state allocated from an arena the caller owns, reset first and
+// kept afterwards, so the library can still free it when running out of memory jumps
+// out of the search.
+int local_search_in(struct arena* arena, struct graph* G, int* dom, int size, double time_limit, int bound,
+        atomic_int* shared_best) {
+    struct local_search ls_state;
+    struct local_search* ls = &ls_state;
+    ls_build(ls, G, arena);
+
+    int i, v;
+    for(i = 0; i < G->vertex_count; i++) {
+        if(IS_ELEMENT(dom, i)) {
+            ls_add(ls, i);
+        }
+    }
+
+    int best_size = size;
+    long move;
+    for(move = 0; ; move++) {
+        if(best_size <= bound || out_of_time(time_limit)) {
+            break;
+        }
+        if(shared_best != NULL && atomic_load_explicit(shared_best, memory_order_relaxed) <= bound) {
+            break;
+        }
+
+        if(!ls->undom_count) {
+            if(ls->size < best_size) {
+                best_size = ls->size;
+                memset(dom, 0, G->m * sizeof(int));
+                for(i = 0; i < ls->size; i++) {
+                    ADD_ELEMENT(dom, ls->members[i]);
+                }
+                stats_found(best_size);
+            }
+            if(!ls->size) {
+                break;
+            }
+
+            // look for a set one smaller
+            v = ls_pick_drop(ls, move);
+            ls_drop(ls, v);
+            ls->no_add_until[v] = move + LS_TABU;
+            continue;
+        }
+
+        // swap a member for a vertex that dominates an undominated vertex
+        if(ls->size) {
+            v = ls_pick_drop(ls, move);
+            ls_drop(ls, v);
+            ls->no_add_until[v] = move + LS_TABU;
+        }
+
+        v = ls_pick_add(ls, move);
+        ls_add(ls, v);
+        ls->no_drop_until[v] = move + LS_TABU;
+    }
+
+    stats_move(move);
+    return best_size;
+}
+
+// Set up the neighbourhood lists and an empty dominating set, exits if out of memory.
+// Parameters:
+//   ls: the search state to set up.
+//   G: the graph to search.
+//   arena: the arena to allocate the state from, reset first.
+void ls_build(struct local_search* ls, struct graph* G, struct arena* arena) {
+    int n = G->vertex_count;
+    int i;
+
+    arena_reset(arena);
+    ls->arena = arena;
+    ls->vertex_count = n;
+    closed_neighbourhoods(G, ls->arena, &ls->start, &ls->nbr);
+    ls->num_dom = arena_alloc(ls->arena, n * sizeof(int));
+    ls->members = arena_alloc(ls->arena, n * sizeof(int));
+    ls->member_pos = arena_alloc(ls->arena, n * sizeof(int));
+    ls->undom = arena_alloc(ls->arena, n * sizeof(int));
+    ls->undom_pos = arena_alloc(ls->arena, n * sizeof(int));
+    ls->no_add_until = arena_alloc(ls->arena, n * sizeof(long));
+    ls->no_drop_until = arena_alloc(ls->arena, n * sizeof(long));
+
+    for(i = 0; i < n; i++) {
+        ls->num_dom[i] = 0;
+        ls->member_pos[i] = -1;
+        ls->undom[i] = i;
+        ls->undom_pos[i] = i;
+        ls->no_add_until[i] = 0;
+        ls->no_drop_until[i] = 0;
+    }
+    ls->size = 0;
+    ls->undom_count = n;
+}
+
+// Add a vertex to the dominating set.
+void ls_add(struct local_search* ls, int v) {
+    int i, u, last;
+
+    ls->member_pos[v] = ls->size;
+    ls->members[ls->size++] = v;
+
+    for(i = ls->start[v]; i < ls->start[v + 1]; i++) {
+        u = ls->nbr[i];
+        if(!ls->num_dom[u]++) {
+            // u is dominated now, move the last undominated vertex into its place
+            last = ls->undom[--ls->undom_count];
+            ls->undom[ls->undom_pos[u]] = last;
+            ls->undom_pos[last] = ls->undom_pos[u];
+            ls->undom_pos[u] = -1;
+        }
+    }
+}
+
+// Remove a vertex from the dominating set.
+void ls_drop(struct local_search* ls, int v) {
+    int i, u, last;
+
+    last = ls->members[--ls->size];
+    ls->members[ls->member_pos[v]] = last;
+    ls->member_pos[last] = ls->member_pos[v];
+    ls->member_pos[v] = -1;
+
+    for(i = ls->start[v]; i < ls->start[v + 1]; i++) {
+        u = ls->nbr[i];
+        if(!--ls->num_dom[u]) {
+            ls->undom_pos[u] = ls->undom_count;
+            ls->undom[ls->undom_count++] = u;
+        }
+    }
+}
+
+// Number of vertices adding v would dominate that are undominated now.
+int ls_gain(struct local_search* ls, int v) {
+    int i, gain = 0;
+    for(i = ls->start[v]; i < ls->start[v + 1]; i++) {
+        if(!ls->num_dom[ls->nbr[i]]) {
+            gain++;
+        }
+    }
+    return gain;
+}
+
+// Number of vertices removing member v would leave undominated.
+int ls_loss(struct local_search* ls, int v) {
+    int i, loss = 0;
+    for(i = ls->start[v]; i < ls->start[v + 1]; i++) {
+        if(ls->num_dom[ls->nbr[i]] == 1) {
+            loss++;
+        }
+    }
+    return loss;
+}
+
+// Choose the member to remove: the smallest loss among a sample of the members,
+// skipping members added in the last LS_TABU moves where possible.
+// Parameters:
+//   ls: the search state, must have at least one member.
+//   move: the current move number.
+//
+// Returns the member to remove.
+int ls_pick_drop(struct local_search* ls, long move) {
+    int i, v, loss;
+    int best = -1;
+    int best_loss = ls->vertex_count + 1;
+    int sample = ls->size < LS_SAMPLE ? ls->size : LS_SAMPLE;
+
+    for(i = 0; i < sample; i++) {
+        v = ls->size <= LS_SAMPLE ? ls->members[i] : ls->members[random_at_most(ls->size - 1)];
+        if(ls->no_drop_until[v] > move) {
+            continue;
+        }
+
+        loss = ls_loss(ls, v);
+        if(loss < best_loss || (loss == best_loss && random_at_most(1))) {
+            best = v;
+            best_loss = loss;
+        }
+    }
+
+    if(best < 0) {
+        best = ls->members[random_at_most(ls->size - 1)];
+    }
+    return best;
+}
+
+// Choose the vertex to add: the largest gain among the closed neighbourhood
+// of a random undominated vertex, skipping vertices removed in the last LS_TABU moves
+// where possible.
+// Parameters:
+//   ls: the search state, must have an undominated vertex.
+//   move: the current move number.
+//
+// Returns the vertex to add.
+int ls_pick_add(struct local_search* ls, long move) {
+    int x = ls->undom[random_at_most(ls->undom_count - 1)];
+    int i, v, gain;
+    int best = x;
+    int best_gain = -1;
+
+    for(i = ls->start[x]; i < ls->start[x + 1]; i++) {
+        v = ls->nbr[i];
+        if(ls->no_add_until[v] > move) {
+            continue;
+        }
+
+        gain = ls_gain(ls, v);
+        if(gain > best_gain || (gain == best_gain && random_at_most(1))) {
+            best = v;
+            best_gain = gain;
+        }
+    }
+
+    return best;
+}
+
+#endif
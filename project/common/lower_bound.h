@@ -0,0 +1,177 @@
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+#include <string.h>
+
+#include "arena.h"
+#include "bitset.h"
+#include "graph.h"
+
+// Lower bounds on the size of a minimum dominating set. The heuristics stop as soon
+// as they find a set this small since it must be a minimum dominating set.
+
+int lower_bound(struct graph*, struct arena*);
+int degree_bound(int, int*, int*);
+int packing_bound(struct graph*, int*, int*, struct arena*);
+int dual_bound(struct graph*, int*);
+
+// Compute the best of the lower bounds below.
+// Parameters:
+//   G: the graph.
+//   arena: the arena to allocate scratch space from.
+//
+// Returns a lower bound on the size of a dominating set of G.
+int lower_bound(struct graph* G, struct arena* arena) {
+    int n = G->vertex_count;
+    int* degree = arena_alloc(arena, n * sizeof(int));
+    int* count = arena_alloc(arena, (n + 1) * sizeof(int));
+    int i, bound, best;
+
+    for(i = 0; i < n; i++) {
+        degree[i] = graph_degree(G, i);
+    }
+
+    best = degree_bound(n, degree, count);
+    bound = packing_bound(G, degree, count, arena);
+    if(bound > best) {
+        best = bound;
+    }
+    bound = dual_bound(G, degree);
+    if(bound > best) {
+        best = bound;
+    }
+
+    return best;
+}
+
+// A member dominates at most its degree + 1 vertices, so a dominating set needs at least
+// as many members as it takes of the largest closed neighbourhoods to add up to vertex_count.
+// This is never less than ceil(vertex_count / (max_deg + 1)).
+// Parameters:
+//   vertex_count: the total number of vertices.
+//   degree: the degree of each vertex.
+//   count: space for vertex_count + 1 counts.
+//
+// Returns the bound.
+int degree_bound(int vertex_count, int* degree, int* count) {
+    int d, k, covered;
+
+    memset(count, 0, (vertex_count + 1) * sizeof(int));
+    for(d = 0; d < vertex_count; d++) {
+        count[degree[d]]++;
+    }
+
+    k = 0;
+    covered = 0;
+    for(d = vertex_count - 1; d >= 0 && covered < vertex_count; d--) {
+        for(; count[d] > 0 && covered < vertex_count; count[d]--) {
+            covered += d + 1;
+            k++;
+        }
+    }
+
+    return k;
+}
+
+// Vertices whose closed neighbourhoods do not overlap (a 2-packing) each need a different
+// member to dominate them, so a 2-packing is never larger than a dominating set.
+// The packing is built greedily, taking the vertices of smallest degree first.
+// Parameters:
+//   G: the graph.
+//   degree: the degree of each vertex.
+//   count: space for vertex_count + 1 counts.
+//   arena: the arena to allocate scratch space from.
+//
+// Returns the size of the packing found.
+int packing_bound(struct graph* G, int* degree, int* count, struct arena* arena) {
+    int vertex_count = G->vertex_count;
+    int m = G->m;
+    int* covered = arena_zalloc(arena, m * sizeof(int));
+    int* order = arena_alloc(arena, vertex_count * sizeof(int));
+    int* row;
+    int i, j, it, u, v, d, packed;
+
+    // counting sort by degree
+    memset(count, 0, (vertex_count + 1) * sizeof(int));
+    for(v = 0; v < vertex_count; v++) {
+        count[degree[v] + 1]++;
+    }
+    for(d = 1; d <= vertex_count; d++) {
+        count[d] += count[d - 1];
+    }
+    for(v = 0; v < vertex_count; v++) {
+        order[count[degree[v]]++] = v;
+    }
+
+    packed = 0;
+    for(i = 0; i < vertex_count; i++) {
+        v = order[i];
+        if(IS_ELEMENT(covered, v)) {
+            continue;
+        }
+
+        if(G->dense) {
+            // a word of the row at a time
+            row = ROW(G, v);
+            for(j = 0; j < m; j++) {
+                if(row[j] & covered[j]) {
+                    break;
+                }
+            }
+            if(j < m) {
+                continue;
+            }
+
+            for(j = 0; j < m; j++) {
+                covered[j] |= row[j];
+            }
+        } else {
+            for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+                if(IS_ELEMENT(covered, u)) {
+                    break;
+                }
+            }
+            if(u >= 0) {
+                continue;
+            }
+
+            for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+                ADD_ELEMENT(covered, u);
+            }
+        }
+        ADD_ELEMENT(covered, v);
+        packed++;
+    }
+
+    return packed;
+}
+
+// A feasible solution of the dual of the dominating set linear program:
+// giving vertex v the weight 1 / (largest degree + 1 in its closed neighbourhood) puts
+// a total weight of at most 1 in every closed neighbourhood, so the sum of the weights
+// is at most the size of any dominating set.
+// Parameters:
+//   G: the graph.
+//   degree: the degree of each vertex.
+//
+// Returns the bound.
+int dual_bound(struct graph* G, int* degree) {
+    double total = 0;
+    int v, u, it, largest;
+
+    for(v = 0; v < G->vertex_count; v++) {
+        largest = degree[v];
+        for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+            if(degree[u] > largest) {
+                largest = degree[u];
+            }
+        }
+        total += 1.0 / (largest + 1);
+    }
+
+    // round up, allowing for rounding error in the sum
+    v = (int) total;
+    return total - v > 1e-9 ? v + 1 : v;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stats.h"
+
+// Options shared by the heuristics, given after their required arguments:
+//   --seed <seed>: seed for the random choices, so a run can be repeated.
+//   --budget <seconds>: time limit for the whole input, shared by the graphs.
+//   --stats: print statistics for each graph to standard error, see stats.h.
+
+int parse_options(int, char*[], int, uint64_t*, double*);
+
+// Read the options following a program's required arguments.
+// Without --seed the seed comes from the clock and process id.
+// Without --budget the budget is 0, meaning no limit. --stats sets report_stats.
+// Parameters:
+//   argc: the argument count passed to main.
+//   argv: the arguments passed to main.
+//   required: the argument count without options, including the program name.
+//   seed: a location to store the seed.
+//   budget: a location to store the budget.
+//
+// Returns 1 if the arguments are valid and 0 otherwise.
+int parse_options(int argc, char* argv[], int required, uint64_t* seed, double* budget) {
+    if(argc < required) {
+        return 0;
+    }
+
+    *seed = (uint64_t) time(NULL) << 20 ^ (uint64_t) getpid();
+    *budget = 0;
+
+    int i;
+    char* end;
+    for(i = required; i < argc; i += 2) {
+        if(!strcmp(argv[i], "--stats")) {
+            report_stats = 1;
+            i--;
+            continue;
+        }
+
+        if(i + 1 == argc || argv[i + 1][0] == '\0') {
+            return 0;
+        }
+
+        if(!strcmp(argv[i], "--seed")) {
+            *seed = strtoull(argv[i + 1], &end, 10);
+        } else if(!strcmp(argv[i], "--budget")) {
+            *budget = strtod(argv[i + 1], &end);
+        } else {
+            return 0;
+        }
+
+        if(*end != '\0') {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <string.h>
+
+// Buffered output for printing graphs and sets.
+// A printf per number is slow for large graphs, so numbers are formatted by hand into
+// a large buffer that is handed to stdout in one fwrite when it fills or on output_flush.
+// Call output_flush before printing anything with printf, so the output stays in order.
+
+// Bytes buffered before they are written.
+#define OUTPUT_BUFFER (1 << 20)
+
+static struct {
+    char data[OUTPUT_BUFFER];
+    size_t size;
+} output;
+
+void output_reserve(size_t);
+void output_char(char);
+void output_int(int, int);
+void output_flush();
+
+// Make room in the buffer, writing it out if it is too full.
+// Parameters:
+//   bytes: the number of bytes about to be added, at most OUTPUT_BUFFER.
+void output_reserve(size_t bytes) {
+    if(output.size + bytes > OUTPUT_BUFFER) {
+        fwrite(output.data, 1, output.size, stdout);
+        output.size = 0;
+    }
+}
+
+// Add a character to the output.
+void output_char(char c) {
+    output_reserve(1);
+    output.data[output.size++] = c;
+}
+
+// Add an integer to the output, right aligned in a field as printf("%*d", width, value).
+// Parameters:
+//   value: the integer.
+//   width: the minimum number of characters, padded with spaces on the left.
+void output_int(int value, int width) {
+    char digits[12];
+    int count = 0;
+    unsigned int v = value < 0 ? -(unsigned int) value : (unsigned int) value;
+
+    do {
+        digits[count++] = '0' + v % 10;
+        v /= 10;
+    } while(v);
+    if(value < 0) {
+        digits[count++] = '-';
+    }
+
+    output_reserve(width > count ? width : count);
+    for(; width > count; width--) {
+        output.data[output.size++] = ' ';
+    }
+    while(count) {
+        output.data[output.size++] = digits[--count];
+    }
+}
+
+// Write out everything buffered and flush stdout.
+void output_flush() {
+    fwrite(output.data, 1, output.size, stdout);
+    output.size = 0;
+    fflush(stdout);
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "graph.h"
+#include "output.h"
+
+// Reading, solving and printing graphs at the same time.
+// A reader thread reads and checks the next graphs while the main thread solves one,
+// and a writer thread prints the results, so the time per graph is spent solving.
+// The graphs pass through PIPELINE_SLOTS slots in turn, each with its own arena:
+// a slot is read into once the writer has printed the graph it last held, so at most
+// that many graphs are in memory at once.
+//
+// The main thread takes each graph with pipeline_next, allocates from the slot's arena
+// and hands the result to pipeline_write. If the reader finds an invalid graph it waits
+// until every graph before it has been printed before reporting it, so the output is
+// the same as reading, solving and printing one graph at a time.
+
+// One slot being read, one solved and one printed.
+#define PIPELINE_SLOTS 3
+
+struct pipeline_slot {
+    struct arena arena; // storage for the graph and everything allocated while solving it
+    struct graph G;
+    int graph_num;
+    long start; // offset of the graph in standard input, for graph_time_limit
+    long end; // offset just past the graph
+
+    // the result, set by pipeline_write
+    int size;
+    int bound;
+    int* dom;
+};
+
+struct pipeline {
+    struct pipeline_slot slots[PIPELINE_SLOTS];
+    int verbose;
+    pthread_t reader;
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t changed; // signalled whenever one of the counts below changes
+
+    // graphs through each stage so far, each count at most the one before
+    int read;
+    int solved;
+    int written;
+    int graph_count; // the number of graphs in the input once the reader finds its end, -1 before
+};
+
+// The pipeline of the process, for bad_graph_hook.
+static struct pipeline* pipeline_active;
+
+void pipeline_start(struct pipeline*, int);
+struct pipeline_slot* pipeline_next(struct pipeline*);
+void pipeline_write(struct pipeline*, struct pipeline_slot*, int, int, int*);
+void pipeline_finish(struct pipeline*);
+void* pipeline_read(void*);
+void* pipeline_print(void*);
+void pipeline_wait_written(int);
+
+// Start reading and printing graphs.
+// Parameters:
+//   pl: the pipeline to start.
+//   verbose: print each graph and its set if 1, a line per graph if 0.
+void pipeline_start(struct pipeline* pl, int verbose) {
+    int i;
+    for(i = 0; i < PIPELINE_SLOTS; i++) {
+        arena_init(&pl->slots[i].arena);
+    }
+    pl->verbose = verbose;
+    pl->read = pl->solved = pl->written = 0;
+    pl->graph_count = -1;
+    pthread_mutex_init(&pl->lock, NULL);
+    pthread_cond_init(&pl->changed, NULL);
+
+    pipeline_active = pl;
+    bad_graph_hook = pipeline_wait_written;
+    pthread_create(&pl->reader, NULL, pipeline_read, pl);
+    pthread_create(&pl->writer, NULL, pipeline_print, pl);
+}
+
+// Take the next graph to solve, waiting for the reader if it is not ready.
+// Parameters:
+//   pl: the pipeline.
+//
+// Returns the slot holding the graph, or NULL at the end of the input.
+struct pipeline_slot* pipeline_next(struct pipeline* pl) {
+    int next = pl->solved + 1;
+    int ready;
+
+    pthread_mutex_lock(&pl->lock);
+    while(pl->read < next && pl->graph_count < 0) {
+        pthread_cond_wait(&pl->changed, &pl->lock);
+    }
+    ready = pl->read >= next;
+    pthread_mutex_unlock(&pl->lock);
+
+    return ready ? &pl->slots[(next - 1) % PIPELINE_SLOTS] : NULL;
+}
+
+// Hand a solved graph to the writer.
+// Parameters:
+//   pl: the pipeline.
+//   slot: the slot from pipeline_next.
+//   size: the size of the dominating set found.
+//   bound: the lower bound on its size.
+//   dom: the dominating set, in the slot's arena or kept until the pipeline finishes.
+void pipeline_write(struct pipeline* pl, struct pipeline_slot* slot, int size, int bound, int* dom) {
+    slot->size = size;
+    slot->bound = bound;
+    slot->dom = dom;
+
+    pthread_mutex_lock(&pl->lock);
+    pl->solved = slot->graph_num;
+    pthread_cond_broadcast(&pl->changed);
+    pthread_mutex_unlock(&pl->lock);
+}
+
+// Wait for the last graph to be printed and free the slots.
+// Parameters:
+//   pl: the pipeline, after pipeline_next returned NULL.
+void pipeline_finish(struct pipeline* pl) {
+    int i;
+    pthread_join(pl->reader, NULL);
+    pthread_join(pl->writer, NULL);
+    bad_graph_hook = NULL;
+    for(i = 0; i < PIPELINE_SLOTS; i++) {
+        arena_free(&pl->slots[i].arena);
+    }
+    pthread_mutex_destroy(&pl->lock);
+    pthread_cond_destroy(&pl->changed);
+}
+
+// The reader thread: read and check each graph into the next free slot.
+void* pipeline_read(void* arg) {
+    struct pipeline* pl = arg;
+    struct pipeline_slot* slot;
+    int graph_num;
+    int more;
+
+    for(graph_num = 1; ; graph_num++) {
+        slot = &pl->slots[(graph_num - 1) % PIPELINE_SLOTS];
+
+        pthread_mutex_lock(&pl->lock);
+        while(pl->written < graph_num - PIPELINE_SLOTS) {
+            pthread_cond_wait(&pl->changed, &pl->lock);
+        }
+        pthread_mutex_unlock(&pl->lock);
+
+        arena_reset(&slot->arena);
+        slot->graph_num = graph_num;
+        slot->start = input_offset();
+        more = read_graph(&slot->G, &slot->arena, graph_num);
+        if(more) {
+            check_graph(&slot->G, graph_num);
+            slot->end = input_offset();
+        }
+
+        pthread_mutex_lock(&pl->lock);
+        if(more) {
+            pl->read = graph_num;
+        } else {
+            pl->graph_count = graph_num - 1;
+        }
+        pthread_cond_broadcast(&pl->changed);
+        pthread_mutex_unlock(&pl->lock);
+
+        if(!more) {
+            return NULL;
+        }
+    }
+}
+
+// The writer thread: print each solved graph and flush it.
+void* pipeline_print(void* arg) {
+    struct pipeline* pl = arg;
+    struct pipeline_slot* slot;
+    int graph_num;
+
+    for(graph_num = 1; ; graph_num++) {
+        pthread_mutex_lock(&pl->lock);
+        while(pl->solved < graph_num && (pl->graph_count < 0 || graph_num <= pl->graph_count)) {
+            pthread_cond_wait(&pl->changed, &pl->lock);
+        }
+        pthread_mutex_unlock(&pl->lock);
+        if(pl->solved < graph_num) {
+            return NULL;
+        }
+
+        slot = &pl->slots[(graph_num - 1) % PIPELINE_SLOTS];
+        if(pl->verbose) {
+           print_graph(&slot->G);
+           print_dom_set(slot->size, slot->G.vertex_count, slot->dom);
+        } else {
+           printf("%4d %4d   %3d   %3d %3d\n", graph_num, slot->G.vertex_count, slot->size, slot->bound,
+               slot->size - slot->bound);
+        }
+        output_flush();
+
+        pthread_mutex_lock(&pl->lock);
+        pl->written = graph_num;
+        pthread_cond_broadcast(&pl->changed);
+        pthread_mutex_unlock(&pl->lock);
+    }
+}
+
+// The bad_graph_hook of the reader: wait until the graphs before an invalid one are printed.
+// Parameters:
+//   graph_num: the number of the invalid graph.
+void pipeline_wait_written(int graph_num) {
+    struct pipeline* pl = pipeline_active;
+
+    pthread_mutex_lock(&pl->lock);
+    while(pl->written < graph_num - 1) {
+        pthread_cond_wait(&pl->changed, &pl->lock);
+    }
+    pthread_mutex_unlock(&pl->lock);
+}
+
+#endif
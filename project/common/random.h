@@ -0,0 +1,113 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Random numbers for the heuristics from xoshiro256** by Blackman and Vigna.
+// Every thread has its own generator, seeded with seed_random before use.
+// Different streams of the same seed are 2^128 numbers apart so they never overlap.
+
+struct rng {
+    uint64_t s[4];
+};
+
+// The generator of the calling thread.
+static _Thread_local struct rng thread_rng;
+
+void seed_random(uint64_t, uint64_t);
+uint64_t next_random();
+uint32_t random_below(uint32_t);
+long random_at_most(long);
+void shuffle(int, int*);
+
+// Seed the calling thread's generator.
+// Parameters:
+//   seed: the seed for the run.
+//   stream: a different number for each thread sharing the seed.
+void seed_random(uint64_t seed, uint64_t stream) {
+    // expand the seed with splitmix64
+    int i, b, w;
+    for(i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        thread_rng.s[i] = z ^ (z >> 31);
+    }
+
+    // each jump is 2^128 calls to next_random
+    static const uint64_t jump[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+    uint64_t s[4];
+    for(; stream > 0; stream--) {
+        memset(s, 0, sizeof(s));
+        for(w = 0; w < 4; w++) {
+            for(b = 0; b < 64; b++) {
+                if(jump[w] & (uint64_t) 1 << b) {
+                    for(i = 0; i < 4; i++) {
+                        s[i] ^= thread_rng.s[i];
+                    }
+                }
+                next_random();
+            }
+        }
+        memcpy(thread_rng.s, s, sizeof(s));
+    }
+}
+
+// Returns the next 64 random bits of the calling thread's generator.
+uint64_t next_random() {
+    uint64_t* s = thread_rng.s;
+    uint64_t x = s[1] * 5;
+    uint64_t result = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+
+    return result;
+}
+
+// Returns a uniform number in [0, bound) using Lemire's multiply and reject method.
+// Assumes bound > 0.
+uint32_t random_below(uint32_t bound) {
+    uint64_t m = (next_random() >> 32) * bound;
+    uint32_t low = (uint32_t) m;
+
+    if(low < bound) {
+        // reject the few products that would make some results more likely
+        uint32_t threshold = -bound % bound;
+        while(low < threshold) {
+            m = (next_random() >> 32) * bound;
+            low = (uint32_t) m;
+        }
+    }
+
+    return m >> 32;
+}
+
+// Assumes 0 <= max < 2^32 - 1
+// Returns in the closed interval [0, max]
+long random_at_most(long max) {
+    return random_below((uint32_t) max + 1);
+}
+
+// Shuffle an array uniformly at random.
+// Parameters:
+//   size: the length of the array.
+//   p: the array to shuffle.
+void shuffle(int size, int* p) {
+    int i, j, t;
+    for(i = size - 1; i > 0; i--) {
+        j = random_below(i + 1);
+        t = p[i];
+        p[i] = p[j];
+        p[j] = t;
+    }
+}
+
+#endif
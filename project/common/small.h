@@ -0,0 +1,295 @@
+#ifndef SMALL_H
+#define SMALL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "graph.h"
+#include "timer.h"
+
+// Kernels for graphs of at most SMALL_MAX vertices, on the closed neighbourhood masks
+// kept in G->closed. A set of vertices is one, two or four 64 bit words, so every set
+// operation is a few instructions on registers instead of a loop over longwords.
+//
+// Each kernel is written once as an always inline function of the word count, and a
+// copy is made for each size class by calling it with a constant, which the compiler
+// unrolls into straight-line code. The size class is picked at run time from n.
+
+#define ALWAYS_INLINE static inline __attribute__((always_inline))
+
+int small_evaluate(struct graph*, int*, int*);
+int small_search(struct graph*, double, int, int*, int*);
+int small_evaluate_1(struct graph*, int*, int*);
+int small_evaluate_2(struct graph*, int*, int*);
+int small_evaluate_4(struct graph*, int*, int*);
+int small_search_1(struct graph*, double, int, int*, int*);
+int small_search_2(struct graph*, double, int, int*, int*);
+int small_search_4(struct graph*, double, int, int*, int*);
+
+// Fill a mask with the vertices of an n vertex graph.
+ALWAYS_INLINE void small_all(uint64_t* set, int n, const int words) {
+    int w;
+    for(w = 0; w < words; w++) {
+        set[w] = n >= 64 * (w + 1) ? UINT64_MAX : n > 64 * w ? ((uint64_t) 1 << (n - 64 * w)) - 1 : 0;
+    }
+}
+
+// Returns the number of vertices in a mask.
+ALWAYS_INLINE int small_size(const uint64_t* set, const int words) {
+    int w, size = 0;
+    for(w = 0; w < words; w++) {
+        size += __builtin_popcountll(set[w]);
+    }
+    return size;
+}
+
+// Returns the number of vertices in both masks.
+ALWAYS_INLINE int small_common(const uint64_t* a, const uint64_t* b, const int words) {
+    int w, size = 0;
+    for(w = 0; w < words; w++) {
+        size += __builtin_popcountll(a[w] & b[w]);
+    }
+    return size;
+}
+
+// Returns the smallest vertex in a mask, or -1 if it is empty.
+ALWAYS_INLINE int small_first(const uint64_t* set, const int words) {
+    int w;
+    for(w = 0; w < words; w++) {
+        if(set[w]) {
+            return 64 * w + __builtin_ctzll(set[w]);
+        }
+    }
+    return -1;
+}
+
+// Convert a mask to a set of G->m longwords, see bitset.h.
+ALWAYS_INLINE void small_to_set(const uint64_t* mask, int m, int* set, const int words) {
+    uint64_t bits;
+    int w;
+    memset(set, 0, m * sizeof(int));
+    for(w = 0; w < words; w++) {
+        for(bits = mask[w]; bits; bits &= bits - 1) {
+            ADD_ELEMENT(set, 64 * w + __builtin_ctzll(bits));
+        }
+    }
+}
+
+// evaluate of dom_set.h on the masks, giving the same set for the same ordering.
+// num_choice of a vertex is the size of its closed neighbourhood within live, the vertices
+// not yet made blue, so instead of counting, a vertex may be made blue if every vertex of
+// its closed neighbourhood has another live vertex in its own.
+ALWAYS_INLINE int small_evaluate_words(struct graph* G, int* p, int* dom, const int words) {
+    const uint64_t* closed = G->closed;
+    int n = G->vertex_count;
+    uint64_t live[4], red[4], dominated[4], all[4], bits, other, bit;
+    const uint64_t* nbrs;
+    int level, u, x, w, v, blue, done;
+
+    small_all(all, n, words);
+    for(w = 0; w < words; w++) {
+        live[w] = all[w];
+        red[w] = 0;
+        dominated[w] = 0;
+    }
+
+    done = 0;
+    for(level = 0; level < n && !done; level++) {
+        u = p[level];
+        nbrs = closed + (size_t) u * words;
+        bit = (uint64_t) 1 << (u & 63);
+
+        // try u blue, it stays so if every vertex of its neighbourhood has a live vertex left
+        live[u >> 6] &= ~bit;
+        blue = 1;
+        for(w = 0; w < words && blue; w++) {
+            for(bits = nbrs[w]; bits && blue; bits &= bits - 1) {
+                x = 64 * w + __builtin_ctzll(bits);
+                other = 0;
+                for(v = 0; v < words; v++) {
+                    other |= closed[(size_t) x * words + v] & live[v];
+                }
+                blue = other != 0;
+            }
+        }
+
+        if(!blue) {
+            live[u >> 6] |= bit;
+            red[u >> 6] |= bit;
+            done = 1;
+            for(w = 0; w < words; w++) {
+                dominated[w] |= nbrs[w];
+                done &= dominated[w] == all[w];
+            }
+        }
+    }
+
+    small_to_set(red, G->m, dom, words);
+    return small_size(red, words);
+}
+
+// An exact branch and bound on the masks, for ds_exact in project/lib.
+// The first undominated vertex with the fewest possible members is picked and each of
+// those members is tried in turn, the ones already tried being left out of the later
+// branches. A branch is cut when even members each dominating as many undominated
+// vertices as the best remaining one could not beat the smallest set found.
+// The depth is at most n, so the levels are kept on the C stack without recursion.
+ALWAYS_INLINE int small_search_words(struct graph* G, double seconds, int bound, int* size, int* dom, const int words) {
+    const uint64_t* closed = G->closed;
+    int n = G->vertex_count;
+    uint64_t undominated[SMALL_MAX + 1][4]; // at each level
+    uint64_t allowed[SMALL_MAX + 1][4]; // vertices that may still be put in the set
+    uint64_t candidates[SMALL_MAX + 1][4]; // members left to try for the level's vertex
+    int chosen[SMALL_MAX + 1];
+    uint64_t best[4], bits;
+    int level, u, v, w, count, fewest, cover, most, need;
+    int best_size = *size;
+    int enter = 1;
+    int finished = 1;
+
+    small_all(undominated[0], n, words);
+    small_all(allowed[0], n, words);
+    memset(best, 0, sizeof(best));
+
+    level = 0;
+    while(level >= 0 && best_size > bound) {
+        if(enter) {
+            enter = 0;
+            if(seconds > 0 && out_of_time(seconds)) {
+                finished = 0;
+                break;
+            }
+
+            count = small_size(undominated[level], words);
+            if(!count) {
+                best_size = level;
+                memset(best, 0, sizeof(best));
+                for(v = 0; v < level; v++) {
+                    best[chosen[v] >> 6] |= (uint64_t) 1 << (chosen[v] & 63);
+                }
+                level--;
+                continue;
+            }
+
+            // the best a member could do, and the undominated vertex with the fewest members
+            most = 0;
+            fewest = n + 1;
+            u = -1;
+            for(w = 0; w < words; w++) {
+                for(bits = allowed[level][w]; bits; bits &= bits - 1) {
+                    v = 64 * w + __builtin_ctzll(bits);
+                    cover = small_common(closed + (size_t) v * words, undominated[level], words);
+                    if(cover > most) {
+                        most = cover;
+                    }
+                }
+                for(bits = undominated[level][w]; bits; bits &= bits - 1) {
+                    v = 64 * w + __builtin_ctzll(bits);
+                    cover = small_common(closed + (size_t) v * words, allowed[level], words);
+                    if(cover < fewest) {
+                        fewest = cover;
+                        u = v;
+                    }
+                }
+            }
+
+            need = most ? (count + most - 1) / most : n + 1;
+            if(!fewest || level + need >= best_size) {
+                level--;
+                continue;
+            }
+            for(w = 0; w < words; w++) {
+                candidates[level][w] = closed[(size_t) u * words + w] & allowed[level][w];
+            }
+        }
+
+        v = small_first(candidates[level], words);
+        if(v < 0 || level + 1 >= best_size) {
+            level--;
+            continue;
+        }
+
+        // put v in the set, and leave it out of the later branches of this level
+        candidates[level][v >> 6] &= ~((uint64_t) 1 << (v & 63));
+        allowed[level][v >> 6] &= ~((uint64_t) 1 << (v & 63));
+        chosen[level] = v;
+        for(w = 0; w < words; w++) {
+            undominated[level + 1][w] = undominated[level][w] & ~closed[(size_t) v * words + w];
+            allowed[level + 1][w] = allowed[level][w];
+        }
+        level++;
+        enter = 1;
+    }
+
+    if(best_size < *size) {
+        *size = best_size;
+        small_to_set(best, G->m, dom, words);
+    }
+    return finished;
+}
+
+// Find the dominating set an ordering produces, as evaluate does, on a small graph.
+// Parameters:
+//   G: the graph, with G->closed set.
+//   p: the order in which the vertices are coloured.
+//   dom: a location to store the dominating set.
+//
+// Returns the size of the dominating set.
+int small_evaluate(struct graph* G, int* p, int* dom) {
+    switch(SMALL_WORDS(G->vertex_count)) {
+        case 1:
+            return small_evaluate_1(G, p, dom);
+        case 2:
+            return small_evaluate_2(G, p, dom);
+        default:
+            return small_evaluate_4(G, p, dom);
+    }
+}
+
+// Find a minimum dominating set of a small graph.
+// Parameters:
+//   G: the graph, with G->closed set.
+//   seconds: the time limit, 0 for none, see out_of_time.
+//   bound: stop when a set this small is found, see lower_bound.
+//   size: the size of dom, a set to beat, replaced by the size of the smallest set found.
+//   dom: a dominating set, replaced by the smallest one found.
+//
+// Returns 1 if the search finished, so the set is a minimum one, and 0 if it ran out of time.
+int small_search(struct graph* G, double seconds, int bound, int* size, int* dom) {
+    switch(SMALL_WORDS(G->vertex_count)) {
+        case 1:
+            return small_search_1(G, seconds, bound, size, dom);
+        case 2:
+            return small_search_2(G, seconds, bound, size, dom);
+        default:
+            return small_search_4(G, seconds, bound, size, dom);
+    }
+}
+
+// The copies for each size class.
+int small_evaluate_1(struct graph* G, int* p, int* dom) {
+    return small_evaluate_words(G, p, dom, 1);
+}
+
+int small_evaluate_2(struct graph* G, int* p, int* dom) {
+    return small_evaluate_words(G, p, dom, 2);
+}
+
+int small_evaluate_4(struct graph* G, int* p, int* dom) {
+    return small_evaluate_words(G, p, dom, 4);
+}
+
+int small_search_1(struct graph* G, double seconds, int bound, int* size, int* dom) {
+    return small_search_words(G, seconds, bound, size, dom, 1);
+}
+
+int small_search_2(struct graph* G, double seconds, int bound, int* size, int* dom) {
+    return small_search_words(G, seconds, bound, size, dom, 2);
+}
+
+int small_search_4(struct graph* G, double seconds, int bound, int* size, int* dom) {
+    return small_search_words(G, seconds, bound, size, dom, 4);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+
+#include "timer.h"
+
+// Statistics for benchmarking. With --stats each graph's are printed to standard error,
+// leaving the normal output unchanged, as one line read by project/bench:
+//   stats <graph> <vertices> <size> <bound> <seconds to best> <seconds> <passes> <moves>
+// A pass is one constructive pass, an ordering evaluated or a greedy set built, and a
+// move is one step of the local search. The counters may be updated from any thread,
+// and are left alone without --stats, so the heuristics share nothing between threads.
+
+int report_stats; // set by --stats, see parse_options
+static atomic_long stats_passes;
+static atomic_long stats_moves;
+static atomic_int stats_best_size;
+static _Atomic double stats_best_time;
+
+void stats_start(int);
+void stats_pass(long);
+void stats_move(long);
+void stats_found(int);
+void stats_report(int, int, int, int);
+
+// Start the statistics for a graph, after start_timer.
+// Parameters:
+//   vertex_count: the number of vertices, the size of the set every heuristic starts with.
+void stats_start(int vertex_count) {
+    atomic_store(&stats_passes, 0);
+    atomic_store(&stats_moves, 0);
+    atomic_store(&stats_best_size, vertex_count);
+    atomic_store(&stats_best_time, 0);
+}
+
+// Count constructive passes.
+void stats_pass(long passes) {
+    if(!report_stats) {
+        return;
+    }
+    atomic_fetch_add_explicit(&stats_passes, passes, memory_order_relaxed);
+}
+
+// Count local search moves.
+void stats_move(long moves) {
+    if(!report_stats) {
+        return;
+    }
+    atomic_fetch_add_explicit(&stats_moves, moves, memory_order_relaxed);
+}
+
+// Note a dominating set, keeping the time the smallest was first found.
+// Parameters:
+//   size: the size of the set.
+void stats_found(int size) {
+    if(!report_stats) {
+        return;
+    }
+    int best = atomic_load_explicit(&stats_best_size, memory_order_relaxed);
+    while(size < best) {
+        if(atomic_compare_exchange_weak(&stats_best_size, &best, size)) {
+            atomic_store(&stats_best_time, check_timer());
+            return;
+        }
+    }
+}
+
+// Print the statistics for a graph if --stats was given.
+// Parameters:
+//   graph_num: the graph number.
+//   vertex_count: the number of vertices.
+//   size: the size of the set printed.
+//   bound: the lower bound printed.
+void stats_report(int graph_num, int vertex_count, int size, int bound) {
+    if(!report_stats) {
+        return;
+    }
+    fprintf(stderr, "stats %d %d %d %d %.6f %.6f %ld %ld\n", graph_num, vertex_count, size, bound,
+        atomic_load(&stats_best_time), check_timer(), atomic_load(&stats_passes), atomic_load(&stats_moves));
+}
+
+#endif
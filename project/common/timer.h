@@ -0,0 +1,126 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdio.h>
+#include <time.h>
+#include <sys/stat.h>
+
+// Time limits for the heuristics.
+// Times come from the monotonic clock, so they are wall time however many threads run
+// and are not affected by changes to the system clock.
+//
+// The search loops call out_of_time on every pass. It only reads the clock once a
+// countdown runs out, and adjusts the countdown so the clock is read about every
+// TIMER_RESOLUTION seconds whether a pass takes a microsecond or a second.
+#define TIMER_RESOLUTION 0.001
+
+int max_second; // time limit per graph
+double job_budget; // time limit for the whole input, 0 for none
+static double job_start;
+static _Thread_local double start_time; // see start_timer_at for threads sharing one
+
+// countdown state of each thread, see out_of_time
+static _Thread_local long timer_countdown;
+static _Thread_local long timer_interval = 1;
+static _Thread_local double timer_last;
+
+double clock_seconds();
+void start_job();
+double graph_time_limit(long, long);
+double start_timer();
+void start_timer_at(double);
+double check_timer();
+int out_of_time(double);
+
+// Returns the monotonic clock in seconds.
+double clock_seconds() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Start timing the whole input for job_budget.
+void start_job() {
+    job_start = clock_seconds();
+}
+
+// Find the time limit for a graph. This is max_second unless a job_budget is set,
+// then the rest of the budget is shared by the remaining graphs in proportion to
+// their size in the input. If the input size is unknown, as for a pipe,
+// the graph may use all of the remaining budget.
+// Parameters:
+//   start: offset of the graph in standard input, -1 if unknown.
+//   end: offset just past the graph in standard input, -1 if unknown.
+//
+// Returns the number of seconds the graph may use.
+double graph_time_limit(long start, long end) {
+    double limit = max_second;
+    if(job_budget <= 0) {
+        return limit;
+    }
+
+    double remaining = job_budget - (clock_seconds() - job_start);
+    if(remaining < 0) {
+        remaining = 0;
+    }
+
+    struct stat st;
+    if(start >= 0 && end > start && !fstat(fileno(stdin), &st) && S_ISREG(st.st_mode) && st.st_size > start) {
+        remaining *= (double) (end - start) / (st.st_size - start);
+    }
+
+    return remaining < limit ? remaining : limit;
+}
+
+// Get the start time
+//
+// Returns the start time, for start_timer_at.
+double start_timer() {
+    start_timer_at(clock_seconds());
+    return start_time;
+}
+
+// Start the timer of this thread at a time read by start_timer on another,
+// so threads working on one graph share its time limit.
+// Parameters:
+//   start: the start time returned by start_timer.
+void start_timer_at(double start) {
+    start_time = start;
+    timer_countdown = 0;
+    timer_interval = 1;
+}
+
+// Get the time elapsed since start time
+double check_timer() {
+    return clock_seconds() - start_time;
+}
+
+// Check whether a time limit has passed, reading the clock only now and then.
+// Parameters:
+//   limit: the number of seconds since start_timer allowed.
+//
+// Returns 1 if the limit has passed and 0 otherwise.
+int out_of_time(double limit) {
+    if(--timer_countdown > 0) {
+        return 0;
+    }
+
+    double elapsed = check_timer();
+    if(elapsed - timer_last < TIMER_RESOLUTION) {
+        timer_interval *= 2;
+    } else if(timer_interval > 1) {
+        timer_interval /= 2;
+    }
+    timer_last = elapsed;
+
+    if(elapsed >= limit) {
+        // keep reading the clock, a loop that checks again is still out of time
+        timer_countdown = 0;
+        return 1;
+    }
+
+    timer_countdown = timer_interval;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// This program converts graphs between the text format specified by assignment 2
+// and the binary format of common/binary.h, which the heuristics read without parsing.
+// Graphs are provided through standard input in either format and written to standard output.
+// Every graph is checked on the way, so binary files it writes are marked as validated.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/binary.h"
+
+int main(int argc, char* argv[]) {
+    int to_binary = argc == 2 && !strcmp(argv[1], "binary");
+    if(argc != 2 || (!to_binary && strcmp(argv[1], "text"))) {
+         printf("Usage %s <binary|text>\n", argv[0]);
+         return EXIT_FAILURE;
+    }
+
+    struct arena arena; // storage for the current graph
+    struct graph G; // the graph being converted
+    int graph_num = 1;
+
+    if(to_binary) {
+        write_binary_header(stdout, BINARY_VALIDATED);
+    }
+
+    arena_init(&arena);
+    while(read_graph(&G, &arena, graph_num)) {
+        check_graph(&G, graph_num);
+
+        if(to_binary) {
+            write_binary_graph(stdout, &G, &arena);
+        } else {
+            print_graph(&G);
+            output_flush();
+        }
+
+        graph_num++;
+        arena_reset(&arena);
+    }
+
+    arena_free(&arena);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,740 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// This program keeps a dominating set of a graph that changes by small edits, rather than
+// solving each version of the graph from scratch. Standard input holds the graph in the
+// format of assignment 2, then optionally a dominating set to start from as print_dom_set
+// prints it (its size, then its members), then a stream of updates, one letter each:
+//   a <u> <v>: add the edge uv.
+//   d <u> <v>: delete the edge uv.
+//   n: add a vertex, numbered after every vertex so far.
+//   r <u>: remove vertex u and its edges. Vertex numbers are never reused.
+// Without a starting set the max-coverage greedy finds one.
+//
+// The set is repaired after each update using num_dom, the number of members in the closed
+// neighbourhood of each vertex. A deleted edge or vertex can only leave its ends undominated,
+// and they are covered again by adding whichever of their closed neighbours covers the
+// most of them. Members next to a new edge or member are then dropped if every vertex
+// they dominate has another member. An update therefore costs time in the degrees of the
+// vertices it touches and their neighbours, not in n.
+//
+// A line is printed for each update as soon as it is applied: its number, the new size and
+// the changes to the set, +v for a vertex added and -v for one removed. Every given number of
+// updates a copy of the graph and set is handed to a thread that runs the local search on
+// it. If it finds a smaller set, that set is taken once the thread finishes. The swap is
+// reported as a line like an update's, numbered after the update before it. At the end
+// of the input the final set is printed.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/timer.h"
+#include "../common/stats.h"
+#include "../common/dom_set.h"
+#include "../common/random.h"
+#include "../common/greedy.h"
+#include "../common/local_search.h"
+
+// Vertices the arrays have room for at first.
+#define DYNAMIC_FIRST_CAPACITY 16
+
+struct dynamic {
+    int vertex_count; // vertices so far, removed ones included
+    int capacity; // vertices the arrays have room for
+    int** nbr; // the neighbours of each vertex, in no particular order
+    int* degree;
+    int* nbr_capacity;
+    int* removed;
+    int* num_dom; // members in the closed neighbourhood of each vertex
+    int* members; // the dominating set
+    int* member_pos; // index of each member in members, -1 for non-members
+    int size;
+
+    int* pending; // vertices that may have been left undominated, see dyn_repair
+    int pending_count;
+    int* score; // undominated pending vertices each vertex covers, 0 outside dyn_repair
+    int* scored; // the vertices given a score
+
+    int step; // number of the line being built, see dyn_change
+    int* changed_in; // the step each vertex last joined or left the set in
+    int* was_member; // membership before the step, for vertices changed in it
+    int* changes; // the vertices changed in the step
+    int change_count;
+};
+
+// A local search on a copy of the graph, running on its own thread.
+struct reoptimiser {
+    pthread_t thread;
+    int running;
+    atomic_int done;
+    struct arena arena;
+    struct graph G;
+    int* vertex; // the vertex of the dynamic graph each vertex of G is
+    int* dom; // the set, replaced by the best found
+    int size;
+    double seconds;
+    uint64_t seed;
+    int round; // the random stream of the search, one per search
+};
+
+void* grow_array(void*, size_t, size_t);
+void dyn_init(struct dynamic*, struct graph*);
+void dyn_reserve(struct dynamic*, int);
+int dyn_add_vertex(struct dynamic*);
+int dyn_find(struct dynamic*, int, int);
+void dyn_add_edge(struct dynamic*, int, int);
+void dyn_delete_edge(struct dynamic*, int, int);
+void dyn_remove_vertex(struct dynamic*, int);
+void dyn_join(struct dynamic*, int);
+void dyn_leave(struct dynamic*, int);
+void dyn_change(struct dynamic*, int);
+int dyn_redundant(struct dynamic*, int);
+void dyn_prune_around(struct dynamic*, int);
+void dyn_pend(struct dynamic*, int);
+void dyn_repair(struct dynamic*);
+void dyn_print_step(struct dynamic*, int);
+int read_start_set(struct dynamic*, struct graph*);
+void greedy_start_set(struct dynamic*, struct graph*, struct arena*);
+int apply_update(struct dynamic*, int);
+void read_update_int(int*, int);
+int update_vertex(struct dynamic*, int, int);
+void reopt_start(struct reoptimiser*, struct dynamic*);
+void* reopt_run(void*);
+int reopt_adopt(struct reoptimiser*, struct dynamic*);
+int compare_ints(const void*, const void*);
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    int i;
+    if(argc >= 5 && !strcmp(argv[argc - 2], "--seed")) {
+        seed = strtoull(argv[argc - 1], NULL, 10);
+        argc -= 2;
+    }
+    if(argc != 3) {
+        printf("Usage %s <updates between re-optimisations, 0 for none> <seconds per re-optimisation> [--seed <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int every = atoi(argv[1]);
+
+    struct arena arena; // the graph as read, freed once it is copied
+    struct graph G;
+    struct dynamic dynamic;
+    struct dynamic* d = &dynamic;
+    struct reoptimiser reopt;
+
+    arena_init(&arena);
+    if(!read_graph(&G, &arena, 1)) {
+        printf("Improper graph format, no graph given.\n");
+        return EXIT_FAILURE;
+    }
+    check_graph(&G, 1);
+    dyn_init(d, &G);
+
+    seed_random(seed, 0);
+    if(!read_start_set(d, &G)) {
+        greedy_start_set(d, &G, &arena);
+    }
+    arena_free(&arena);
+    dyn_print_step(d, 0);
+
+    arena_init(&reopt.arena);
+    reopt.running = 0;
+    reopt.seconds = atof(argv[2]);
+    reopt.seed = seed;
+    reopt.round = 0;
+
+    int update;
+    for(update = 1; apply_update(d, update); update++) {
+        dyn_print_step(d, update);
+
+        if(reopt.running && atomic_load(&reopt.done) && reopt_adopt(&reopt, d)) {
+            dyn_print_step(d, update);
+        }
+        if(every > 0 && update % every == 0 && !reopt.running) {
+            reopt_start(&reopt, d);
+        }
+    }
+
+    if(reopt.running && reopt_adopt(&reopt, d)) {
+        dyn_print_step(d, update - 1);
+    }
+
+    int* dom = calloc(SET_WORDS(d->vertex_count) + 1, sizeof(int));
+    if(dom == NULL) {
+        printf("Out of memory printing the set.\n");
+        return EXIT_FAILURE;
+    }
+    for(i = 0; i < d->size; i++) {
+        ADD_ELEMENT(dom, d->members[i]);
+    }
+    print_dom_set(d->size, d->vertex_count, dom);
+    output_flush();
+
+    arena_free(&reopt.arena);
+    return EXIT_SUCCESS;
+}
+
+// Resize an array, exits if out of memory.
+// Parameters:
+//   p: the array, or NULL.
+//   count: the number of elements wanted.
+//   size: the size of an element.
+//
+// Returns the resized array.
+void* grow_array(void* p, size_t count, size_t size) {
+    p = realloc(p, count * size);
+    if(p == NULL) {
+        printf("Out of memory allocating %zu bytes.\n", count * size);
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+// Copy a graph into the dynamic form, with an empty set.
+// Parameters:
+//   d: the dynamic graph to set up.
+//   G: the graph.
+void dyn_init(struct dynamic* d, struct graph* G) {
+    int i, j, it;
+
+    memset(d, 0, sizeof(struct dynamic));
+    dyn_reserve(d, G->vertex_count);
+    for(i = 0; i < G->vertex_count; i++) {
+        dyn_add_vertex(d);
+        d->nbr_capacity[i] = graph_degree(G, i);
+        d->nbr[i] = grow_array(NULL, d->nbr_capacity[i] + 1, sizeof(int));
+        for(it = -1; (j = next_neighbour(G, i, &it)) >= 0;) {
+            d->nbr[i][d->degree[i]++] = j;
+        }
+    }
+}
+
+// Make room for a number of vertices, at least doubling the arrays.
+void dyn_reserve(struct dynamic* d, int vertex_count) {
+    int capacity = d->capacity ? d->capacity : DYNAMIC_FIRST_CAPACITY;
+    while(capacity < vertex_count) {
+        capacity *= 2;
+    }
+    if(capacity == d->capacity) {
+        return;
+    }
+
+    d->nbr = grow_array(d->nbr, capacity, sizeof(int*));
+    d->degree = grow_array(d->degree, capacity, sizeof(int));
+    d->nbr_capacity = grow_array(d->nbr_capacity, capacity, sizeof(int));
+    d->removed = grow_array(d->removed, capacity, sizeof(int));
+    d->num_dom = grow_array(d->num_dom, capacity, sizeof(int));
+    d->members = grow_array(d->members, capacity, sizeof(int));
+    d->member_pos = grow_array(d->member_pos, capacity, sizeof(int));
+    d->pending = grow_array(d->pending, capacity, sizeof(int));
+    d->score = grow_array(d->score, capacity, sizeof(int));
+    d->scored = grow_array(d->scored, capacity, sizeof(int));
+    d->changed_in = grow_array(d->changed_in, capacity, sizeof(int));
+    d->was_member = grow_array(d->was_member, capacity, sizeof(int));
+    d->changes = grow_array(d->changes, capacity, sizeof(int));
+    d->capacity = capacity;
+}
+
+// Add an isolated vertex, outside the set.
+//
+// Returns its number.
+int dyn_add_vertex(struct dynamic* d) {
+    int v = d->vertex_count;
+    dyn_reserve(d, v + 1);
+    d->vertex_count++;
+
+    d->nbr[v] = NULL;
+    d->degree[v] = 0;
+    d->nbr_capacity[v] = 0;
+    d->removed[v] = 0;
+    d->num_dom[v] = 0;
+    d->member_pos[v] = -1;
+    d->score[v] = 0;
+    d->changed_in[v] = -1;
+    return v;
+}
+
+// Returns the index of v in the neighbours of u, or -1 if they are not adjacent.
+int dyn_find(struct dynamic* d, int u, int v) {
+    int i;
+    for(i = 0; i < d->degree[u]; i++) {
+        if(d->nbr[u][i] == v) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Add the edge uv, which is not yet present, keeping num_dom up to date.
+void dyn_add_edge(struct dynamic* d, int u, int v) {
+    int ends[2] = {u, v};
+    int i, a, b;
+    for(i = 0; i < 2; i++) {
+        a = ends[i];
+        b = ends[1 - i];
+        if(d->degree[a] == d->nbr_capacity[a]) {
+            d->nbr_capacity[a] = 2 * d->nbr_capacity[a] + 1;
+            d->nbr[a] = grow_array(d->nbr[a], d->nbr_capacity[a], sizeof(int));
+        }
+        d->nbr[a][d->degree[a]++] = b;
+        if(d->member_pos[b] >= 0) {
+            d->num_dom[a]++;
+        }
+    }
+}
+
+// Delete the edge uv, which is present, keeping num_dom up to date.
+void dyn_delete_edge(struct dynamic* d, int u, int v) {
+    int ends[2] = {u, v};
+    int i, a, b, pos;
+    for(i = 0; i < 2; i++) {
+        a = ends[i];
+        b = ends[1 - i];
+        pos = dyn_find(d, a, b);
+        d->nbr[a][pos] = d->nbr[a][--d->degree[a]];
+        if(d->member_pos[b] >= 0) {
+            d->num_dom[a]--;
+        }
+    }
+}
+
+// Remove a vertex and its edges, leaving its neighbours pending.
+void dyn_remove_vertex(struct dynamic* d, int v) {
+    int u;
+    if(d->member_pos[v] >= 0) {
+        dyn_leave(d, v);
+    }
+    while(d->degree[v]) {
+        u = d->nbr[v][0];
+        dyn_delete_edge(d, v, u);
+        dyn_pend(d, u);
+    }
+    free(d->nbr[v]);
+    d->nbr[v] = NULL;
+    d->nbr_capacity[v] = 0;
+    d->removed[v] = 1;
+}
+
+// Add a vertex to the set.
+void dyn_join(struct dynamic* d, int v) {
+    int i;
+    dyn_change(d, v);
+    d->member_pos[v] = d->size;
+    d->members[d->size++] = v;
+    d->num_dom[v]++;
+    for(i = 0; i < d->degree[v]; i++) {
+        d->num_dom[d->nbr[v][i]]++;
+    }
+}
+
+// Remove a vertex from the set.
+void dyn_leave(struct dynamic* d, int v) {
+    int i;
+    int last = d->members[--d->size];
+    dyn_change(d, v);
+    d->members[d->member_pos[v]] = last;
+    d->member_pos[last] = d->member_pos[v];
+    d->member_pos[v] = -1;
+    d->num_dom[v]--;
+    for(i = 0; i < d->degree[v]; i++) {
+        d->num_dom[d->nbr[v][i]]--;
+    }
+}
+
+// Note the membership of a vertex before its first change in the step.
+void dyn_change(struct dynamic* d, int v) {
+    if(d->changed_in[v] != d->step) {
+        d->changed_in[v] = d->step;
+        d->was_member[v] = d->member_pos[v] >= 0;
+        d->changes[d->change_count++] = v;
+    }
+}
+
+// Returns 1 if v is a member that every vertex it dominates has another member next to.
+int dyn_redundant(struct dynamic* d, int v) {
+    int i;
+    if(d->member_pos[v] < 0 || d->num_dom[v] < 2) {
+        return 0;
+    }
+    for(i = 0; i < d->degree[v]; i++) {
+        if(d->num_dom[d->nbr[v][i]] < 2) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Drop the members in the closed neighbourhood of a vertex that the set does not need.
+void dyn_prune_around(struct dynamic* d, int v) {
+    int i;
+    if(dyn_redundant(d, v)) {
+        dyn_leave(d, v);
+    }
+    for(i = 0; i < d->degree[v]; i++) {
+        if(dyn_redundant(d, d->nbr[v][i])) {
+            dyn_leave(d, d->nbr[v][i]);
+        }
+    }
+}
+
+// Note a vertex that may have been left undominated, for dyn_repair.
+void dyn_pend(struct dynamic* d, int v) {
+    d->pending[d->pending_count++] = v;
+}
+
+// Dominate the pending vertices again. Each round scores the closed neighbours of the
+// pending undominated vertices by how many of them they cover and adds the best.
+void dyn_repair(struct dynamic* d) {
+    int i, j, v, u, best, scored;
+
+    for(;;) {
+        scored = 0;
+        best = -1;
+        for(i = 0; i < d->pending_count; i++) {
+            v = d->pending[i];
+            if(d->removed[v] || d->num_dom[v]) {
+                continue;
+            }
+            for(j = -1; j < d->degree[v]; j++) {
+                u = j < 0 ? v : d->nbr[v][j];
+                if(!d->score[u]++) {
+                    d->scored[scored++] = u;
+                }
+                if(best < 0 || d->score[u] > d->score[best]) {
+                    best = u;
+                }
+            }
+        }
+
+        for(i = 0; i < scored; i++) {
+            d->score[d->scored[i]] = 0;
+        }
+        if(best < 0) {
+            break;
+        }
+        dyn_join(d, best);
+        dyn_prune_around(d, best);
+    }
+    d->pending_count = 0;
+}
+
+// Print a step: its number, the size of the set and the vertices that joined or left it.
+// The output is flushed, so the line is seen as soon as the step is applied.
+// Parameters:
+//   d: the dynamic graph.
+//   number: the number to print for the step.
+void dyn_print_step(struct dynamic* d, int number) {
+    int i, v;
+    output_int(number, 4);
+    output_int(d->size, 5);
+    for(i = 0; i < d->change_count; i++) {
+        v = d->changes[i];
+        if(d->was_member[v] != (d->member_pos[v] >= 0)) {
+            output_char(' ');
+            output_char(d->was_member[v] ? '-' : '+');
+            output_int(v, 0);
+        }
+    }
+    output_char('\n');
+    output_flush();
+
+    d->step++;
+    d->change_count = 0;
+}
+
+
+// Read the set to start from if one follows the graph, and make it dominate.
+// Parameters:
+//   d: the dynamic graph.
+//   G: the graph as read.
+//
+// Returns 1 if a set was read, 0 if the input goes on with updates or ends.
+// Exits if the set is not valid.
+int read_start_set(struct dynamic* d, struct graph* G) {
+    int i, v, size;
+    int c = input_peek();
+    if(c < '0' || c > '9') {
+        return 0;
+    }
+
+    read_update_int(&size, 0);
+    for(i = 0; i < size; i++) {
+        read_update_int(&v, 0);
+        if(v < 0 || v >= G->vertex_count) {
+            printf("*** Error- starting set: vertex %d is not in the range [0, %d]\n", v, G->vertex_count - 1);
+            exit(EXIT_FAILURE);
+        }
+        if(d->member_pos[v] < 0) {
+            dyn_join(d, v);
+        }
+    }
+
+    // a set that does not dominate is repaired rather than refused
+    for(v = 0; v < d->vertex_count; v++) {
+        dyn_pend(d, v);
+    }
+    dyn_repair(d);
+    return 1;
+}
+
+// Find a set to start from with one greedy pass, trimmed by the include/exclude pass.
+// Parameters:
+//   d: the dynamic graph.
+//   G: the graph as read.
+//   arena: the arena of G, for the buffers.
+void greedy_start_set(struct dynamic* d, struct graph* G, struct arena* arena) {
+    struct greedy greedy;
+    int* start;
+    int* nbr;
+    int v;
+    int n = G->vertex_count;
+
+    int* picks = arena_alloc(arena, n * sizeof(int));
+    int* p = arena_alloc(arena, n * sizeof(int));
+    int* num_choice = arena_alloc(arena, n * sizeof(int));
+    int* num_dom = arena_alloc(arena, n * sizeof(int));
+    int* dom = arena_alloc(arena, G->m * sizeof(int));
+
+    closed_neighbourhoods(G, arena, &start, &nbr);
+    greedy_init(&greedy, n, start, nbr, arena);
+    greedy_order(&greedy, picks, greedy_dom_set(&greedy, picks, dom), p);
+    evaluate(G, p, num_choice, num_dom, dom);
+
+    for(v = -1; (v = next_element(dom, G->m, v)) >= 0;) {
+        dyn_join(d, v);
+    }
+}
+
+// Read and apply the next update.
+// Parameters:
+//   d: the dynamic graph.
+//   update: the number of the update, for error messages.
+//
+// Returns 1 if an update was read, 0 at the end of the input.
+// Exits if the input is not an update. An update that does not fit the graph, such as
+// deleting an edge that is not there, is reported and changes nothing.
+int apply_update(struct dynamic* d, int update) {
+    char letter;
+    int u, v;
+
+    if(input_peek() < 0) {
+        return 0;
+    }
+    letter = *(const char*) input_take(1, &letter);
+
+    if(letter == 'n') {
+        dyn_pend(d, dyn_add_vertex(d));
+        dyn_repair(d);
+        return 1;
+    }
+    if(letter == 'r') {
+        read_update_int(&u, update);
+        if(update_vertex(d, update, u)) {
+            dyn_remove_vertex(d, u);
+            dyn_repair(d);
+        }
+        return 1;
+    }
+    if(letter != 'a' && letter != 'd') {
+        output_flush();
+        printf("*** Error- update %d: unknown update '%c'\n", update, letter);
+        exit(EXIT_FAILURE);
+    }
+
+    read_update_int(&u, update);
+    read_update_int(&v, update);
+    if(!update_vertex(d, update, u) || !update_vertex(d, update, v)) {
+        return 1;
+    }
+    if(u == v || (dyn_find(d, u, v) >= 0) == (letter == 'a')) {
+        output_flush();
+        printf("*** Error- update %d: edge %d %d %s\n", update, u, v,
+            u == v ? "would be a loop" : letter == 'a' ? "is already present" : "is not present");
+        return 1;
+    }
+
+    if(letter == 'a') {
+        // the set still dominates, but a member at either end may now cover for others
+        dyn_add_edge(d, u, v);
+        if(d->member_pos[u] >= 0 || d->member_pos[v] >= 0) {
+            dyn_prune_around(d, u);
+            dyn_prune_around(d, v);
+        }
+    } else {
+        dyn_delete_edge(d, u, v);
+        dyn_pend(d, u);
+        dyn_pend(d, v);
+        dyn_repair(d);
+    }
+    return 1;
+}
+
+// Read a number of an update or of the starting set, exits if there is none.
+// Parameters:
+//   value: a location to store the number.
+//   update: the number of the update, 0 for the starting set.
+void read_update_int(int* value, int update) {
+    if(!input_int(value)) {
+        output_flush();
+        if(update) {
+            printf("*** Error- update %d: failed to read a value\n", update);
+        } else {
+            printf("*** Error- starting set: failed to read a value\n");
+        }
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Check that a vertex of an update exists, reporting it if not.
+// Parameters:
+//   d: the dynamic graph.
+//   update: the number of the update.
+//   v: the vertex.
+//
+// Returns 1 if v is a vertex of the graph and 0 otherwise.
+int update_vertex(struct dynamic* d, int update, int v) {
+    if(v >= 0 && v < d->vertex_count && !d->removed[v]) {
+        return 1;
+    }
+    output_flush();
+    printf("*** Error- update %d: vertex %d is not in the graph\n", update, v);
+    return 0;
+}
+
+// Copy the graph and set, numbering the vertices that remain from 0, and start a local search on the copy.
+// Parameters:
+//   r: the re-optimiser, not running.
+//   d: the dynamic graph.
+void reopt_start(struct reoptimiser* r, struct dynamic* d) {
+    struct graph* G = &r->G;
+    int i, j, v;
+    int count = 0;
+    size_t entries = 0;
+
+    arena_reset(&r->arena);
+    int* index = arena_alloc(&r->arena, d->vertex_count * sizeof(int));
+    r->vertex = arena_alloc(&r->arena, d->vertex_count * sizeof(int));
+    for(v = 0; v < d->vertex_count; v++) {
+        if(!d->removed[v]) {
+            index[v] = count;
+            r->vertex[count++] = v;
+            entries += d->degree[v];
+        }
+    }
+
+    // store_graph needs every list in increasing order
+    G->vertex_count = count;
+    G->validated = 1;
+    G->start = arena_alloc(&r->arena, (count + 1) * sizeof(int));
+    int* nbr = arena_alloc(&r->arena, (entries + 1) * sizeof(int));
+    entries = 0;
+    for(i = 0; i < count; i++) {
+        v = r->vertex[i];
+        G->start[i] = entries;
+        for(j = 0; j < d->degree[v]; j++) {
+            nbr[entries + j] = index[d->nbr[v][j]];
+        }
+        qsort(nbr + entries, d->degree[v], sizeof(int), compare_ints);
+        entries += d->degree[v];
+    }
+    G->start[count] = entries;
+    store_graph(G, &r->arena, nbr, entries, 1);
+
+    r->dom = arena_zalloc(&r->arena, (G->m + 1) * sizeof(int));
+    for(i = 0; i < d->size; i++) {
+        ADD_ELEMENT(r->dom, index[d->members[i]]);
+    }
+    r->size = d->size;
+    r->round++;
+    atomic_store(&r->done, 0);
+    r->running = 1;
+    if(pthread_create(&r->thread, NULL, reopt_run, r)) {
+        printf("Unable to start the re-optimisation thread.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Thread body, runs the local search on the copy.
+// Parameters:
+//   arg: the re-optimiser.
+void* reopt_run(void* arg) {
+    struct reoptimiser* r = arg;
+
+    seed_random(r->seed, r->round);
+    start_timer();
+    r->size = local_search(&r->G, r->dom, r->size, r->seconds, r->G.vertex_count > 0, NULL);
+    atomic_store(&r->done, 1);
+    return NULL;
+}
+
+// Wait for the local search and take its set if it is smaller. The updates since the copy
+// may leave vertices undominated, they are repaired, and if the set is then no smaller
+// the old one is put back.
+// Parameters:
+//   r: the re-optimiser, running.
+//   d: the dynamic graph.
+//
+// Returns 1 if the set was replaced and 0 otherwise.
+int reopt_adopt(struct reoptimiser* r, struct dynamic* d) {
+    int i, v;
+
+    pthread_join(r->thread, NULL);
+    r->running = 0;
+    if(r->size >= d->size) {
+        return 0;
+    }
+
+    int old_size = d->size;
+    int* old = arena_alloc(&r->arena, old_size * sizeof(int));
+    memcpy(old, d->members, old_size * sizeof(int));
+    int* chosen = arena_zalloc(&r->arena, d->vertex_count * sizeof(int));
+    for(v = -1; (v = next_element(r->dom, r->G.m, v)) >= 0;) {
+        if(!d->removed[r->vertex[v]]) {
+            chosen[r->vertex[v]] = 1;
+        }
+    }
+
+    for(i = 0; i < old_size; i++) {
+        if(!chosen[old[i]]) {
+            dyn_leave(d, old[i]);
+        }
+    }
+    for(v = 0; v < d->vertex_count; v++) {
+        if(chosen[v] && d->member_pos[v] < 0) {
+            dyn_join(d, v);
+        }
+        if(!d->removed[v] && !d->num_dom[v]) {
+            dyn_pend(d, v);
+        }
+    }
+    dyn_repair(d);
+    if(d->size < old_size) {
+        return 1;
+    }
+
+    // the old set still dominates the graph as it is now
+    memset(chosen, 0, d->vertex_count * sizeof(int));
+    for(i = 0; i < old_size; i++) {
+        chosen[old[i]] = 1;
+    }
+    for(v = 0; v < d->vertex_count; v++) {
+        if(!chosen[v] && d->member_pos[v] >= 0) {
+            dyn_leave(d, v);
+        }
+    }
+    for(i = 0; i < old_size; i++) {
+        if(d->member_pos[old[i]] < 0) {
+            dyn_join(d, old[i]);
+        }
+    }
+    return 0;
+}
+
+// Order ints for qsort.
+int compare_ints(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
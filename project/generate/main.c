@@ -0,0 +1,703 @@
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// This program generates graphs from parameterised families, to test the heuristics on
+// graphs far larger than the inputs in project/custom/inputs:
+//   cube <d>: the d-cube, 2^d vertices adjacent when their labels differ in one bit.
+//   queen <n>: the n x n queen graph, squares adjacent when a queen can move between them.
+//   kneser <n> <k>: the Kneser graph K(n, k), the k-subsets of n adjacent when disjoint.
+//   circulant <n> <jumps>: vertex v adjacent to v +- j mod n for each j in a comma separated list.
+//   gnp <n> <p>: every edge present with chance p.
+//   geometric <n> <r>: random points in the unit square adjacent when at most r apart.
+//   powerlaw <n> <average degree> <exponent>: Chung-Lu graph with a power law degree sequence.
+// Graphs are written to standard output in the text format specified by assignment 2,
+// or with --binary in the format of common/binary.h.
+//
+// The neighbours of a vertex of the first four families and of geometric graphs are
+// found when it is written, so text output streams in O(max degree) memory beyond the
+// points. gnp and powerlaw graphs are built as lists in O(n + m) time first. Binary
+// output needs every list before the header, so it always builds them.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/binary.h"
+#include "../common/output.h"
+#include "../common/random.h"
+
+struct generator {
+    int n;
+    size_t entries; // total length of the lists, or 0 if unknown until they are found
+    int max_degree;
+    int (*neighbours)(struct generator*, int, int*);
+
+    // family parameters
+    int d; // cube dimension
+    int side; // queen board side
+    int kneser_n;
+    int kneser_k;
+    uint64_t* subsets; // the Kneser vertices in increasing order
+    uint64_t (*binomial)[64]; // binomial[a][b] is a choose b, for ranking Kneser vertices
+    int jump_count;
+    int* jumps;
+    double radius; // geometric
+    int cells; // geometric grid side
+    double* x; // geometric points, sorted by cell so cell c holds cell_start[c] to cell_start[c + 1] - 1
+    double* y;
+    int* cell_start;
+
+    // lists, for gnp and powerlaw or when every list is needed
+    int* start;
+    int* nbr;
+};
+
+// Edges found by the random families before they are sorted into lists.
+struct edges {
+    int* u;
+    int* v;
+    size_t count;
+    size_t capacity;
+};
+
+int parse_family(struct generator*, struct arena*, int, char**);
+int cube_neighbours(struct generator*, int, int*);
+int queen_neighbours(struct generator*, int, int*);
+int kneser_neighbours(struct generator*, int, int*);
+int circulant_neighbours(struct generator*, int, int*);
+int geometric_neighbours(struct generator*, int, int*);
+int list_neighbours(struct generator*, int, int*);
+void setup_kneser(struct generator*, struct arena*);
+void setup_geometric(struct generator*, struct arena*);
+void generate_gnp(struct generator*, struct arena*, double);
+void generate_powerlaw(struct generator*, struct arena*, double, double);
+void add_edge(struct edges*, int, int);
+void build_lists(struct generator*, struct arena*, struct edges*);
+void build_all_lists(struct generator*, struct arena*);
+void write_text(struct generator*, struct arena*);
+int grid_cell(double, int);
+double uniform();
+int compare_ints(const void*, const void*);
+void generate_error(const char*);
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    int count = 1;
+    int binary_output = 0;
+    int required, i, graph;
+    struct arena arena;
+    struct generator gen;
+
+    // the family name and its parameters come first, then the options
+    for(required = 2; required < argc && strncmp(argv[required], "--", 2); required++) {
+    }
+    for(i = required; i < argc; i++) {
+        if(!strcmp(argv[i], "--binary")) {
+            binary_output = 1;
+        } else if(!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else {
+            break;
+        }
+    }
+
+    arena_init(&arena);
+    seed_random(seed, 0);
+    if(i != argc || argc < 2 || !parse_family(&gen, &arena, required - 1, argv + 1)) {
+        printf("Usage %s <family> <parameters> [--seed <seed>] [--count <graphs>] [--binary]\n"
+            "Families: cube <d>, queen <n>, kneser <n> <k>, circulant <n> <jumps>, gnp <n> <p>,\n"
+            "          geometric <n> <r>, powerlaw <n> <average degree> <exponent>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(binary_output) {
+        write_binary_header(stdout, 0);
+    }
+
+    // each graph of a random family gets its own stream, so graph i is the same however many are written
+    for(graph = 0; graph < count; graph++) {
+        if(graph) {
+            seed_random(seed, graph);
+            arena_reset(&arena);
+            parse_family(&gen, &arena, required - 1, argv + 1);
+        }
+
+        if(binary_output) {
+            struct graph G;
+            build_all_lists(&gen, &arena);
+            memset(&G, 0, sizeof(G));
+            G.vertex_count = gen.n;
+            G.start = gen.start;
+            G.nbr = gen.nbr;
+            write_binary_graph(stdout, &G, &arena);
+        } else {
+            write_text(&gen, &arena);
+        }
+    }
+    output_flush();
+
+    arena_free(&arena);
+    return EXIT_SUCCESS;
+}
+
+// Read the family and its parameters and set up the generator, building the lists of
+// a random family with the calling thread's generator.
+// Parameters:
+//   gen: the generator to set up.
+//   arena: the arena to allocate from.
+//   argc: the number of arguments, the family name and its parameters.
+//   argv: the arguments.
+//
+// Returns 1 if the parameters are valid for the family, 0 if not.
+int parse_family(struct generator* gen, struct arena* arena, int argc, char** argv) {
+    const char* family = argv[0];
+    long long n;
+    char* list;
+    char* item;
+
+    memset(gen, 0, sizeof(*gen));
+    if(argc < 2) {
+        return 0;
+    }
+    n = atoll(argv[1]);
+
+    if(!strcmp(family, "cube") && argc == 2) {
+        if(n < 0 || n > 30) {
+            generate_error("the dimension must be 0 to 30");
+        }
+        gen->d = n;
+        gen->n = 1 << n;
+        gen->max_degree = n;
+        gen->entries = (size_t) gen->n * n;
+        gen->neighbours = cube_neighbours;
+    } else if(!strcmp(family, "queen") && argc == 2) {
+        if(n < 1 || n * n > INT_MAX) {
+            generate_error("the board is too large");
+        }
+        gen->side = n;
+        gen->n = n * n;
+        gen->max_degree = 4 * (n - 1);
+        gen->neighbours = queen_neighbours;
+    } else if(!strcmp(family, "kneser") && argc == 3) {
+        gen->kneser_n = n;
+        gen->kneser_k = atoi(argv[2]);
+        if(n < 1 || n > 63 || gen->kneser_k < 1 || gen->kneser_k > n) {
+            generate_error("Kneser graphs need 1 <= k <= n <= 63");
+        }
+        setup_kneser(gen, arena);
+        gen->neighbours = kneser_neighbours;
+    } else if(!strcmp(family, "circulant") && argc == 3) {
+        if(n < 1 || n > INT_MAX) {
+            generate_error("the vertex count must be 1 to INT_MAX");
+        }
+        gen->n = n;
+        gen->jumps = arena_alloc(arena, strlen(argv[2]) * sizeof(int));
+        list = arena_alloc(arena, strlen(argv[2]) + 1);
+        strcpy(list, argv[2]);
+        for(item = strtok(list, ","); item != NULL; item = strtok(NULL, ",")) {
+            gen->jumps[gen->jump_count++] = atoi(item);
+        }
+        gen->max_degree = 2 * gen->jump_count;
+        gen->neighbours = circulant_neighbours;
+    } else if(!strcmp(family, "gnp") && argc == 3) {
+        if(n < 0 || n > INT_MAX) {
+            generate_error("the vertex count must be 0 to INT_MAX");
+        }
+        gen->n = n;
+        generate_gnp(gen, arena, atof(argv[2]));
+    } else if(!strcmp(family, "geometric") && argc == 3) {
+        if(n < 0 || n > INT_MAX) {
+            generate_error("the vertex count must be 0 to INT_MAX");
+        }
+        gen->n = n;
+        gen->radius = atof(argv[2]);
+        setup_geometric(gen, arena);
+        gen->neighbours = geometric_neighbours;
+    } else if(!strcmp(family, "powerlaw") && argc == 4) {
+        if(n < 0 || n > INT_MAX) {
+            generate_error("the vertex count must be 0 to INT_MAX");
+        }
+        gen->n = n;
+        generate_powerlaw(gen, arena, atof(argv[2]), atof(argv[3]));
+    } else {
+        return 0;
+    }
+
+    return 1;
+}
+
+// Each neighbours function stores the neighbours of a vertex in increasing order.
+// Parameters:
+//   gen: the generator.
+//   v: the vertex.
+//   out: space for at least max_degree neighbours.
+//
+// Returns the degree of v.
+int cube_neighbours(struct generator* gen, int v, int* out) {
+    int degree = 0;
+    int i;
+
+    // clearing a bit gives a smaller neighbour, the higher the bit the smaller
+    for(i = gen->d - 1; i >= 0; i--) {
+        if(v & (1 << i)) {
+            out[degree++] = v ^ (1 << i);
+        }
+    }
+    for(i = 0; i < gen->d; i++) {
+        if(!(v & (1 << i))) {
+            out[degree++] = v | (1 << i);
+        }
+    }
+    return degree;
+}
+
+int queen_neighbours(struct generator* gen, int v, int* out) {
+    int n = gen->side;
+    int row = v / n;
+    int col = v % n;
+    int degree = 0;
+    int r, c, d;
+
+    // row by row, so the neighbours come out in increasing order
+    for(r = 0; r < n; r++) {
+        if(r == row) {
+            for(c = 0; c < n; c++) {
+                if(c != col) {
+                    out[degree++] = r * n + c;
+                }
+            }
+            continue;
+        }
+
+        d = abs(r - row);
+        if(col - d >= 0) {
+            out[degree++] = r * n + col - d;
+        }
+        out[degree++] = r * n + col;
+        if(col + d < n) {
+            out[degree++] = r * n + col + d;
+        }
+    }
+
+    return degree;
+}
+
+int kneser_neighbours(struct generator* gen, int v, int* out) {
+    int n = gen->kneser_n;
+    int k = gen->kneser_k;
+    int free_count = n - k;
+    int place[64]; // the elements not in subset v, in increasing order
+    uint64_t s, c, r, bits;
+    int degree = 0;
+    int i, j, rank;
+
+    for(i = j = 0; i < n; i++) {
+        if(!(gen->subsets[v] >> i & 1)) {
+            place[j++] = i;
+        }
+    }
+    if(k > free_count) {
+        return 0;
+    }
+
+    // the k-subsets of the other elements, in increasing order, ranked in the
+    // combinatorial number system, which numbers the subsets in the same order
+    s = ((uint64_t) 1 << k) - 1;
+    while(!(s >> free_count)) {
+        rank = 0;
+        for(bits = s, i = 1; bits; bits &= bits - 1, i++) {
+            rank += (int) gen->binomial[place[__builtin_ctzll(bits)]][i];
+        }
+        out[degree++] = rank;
+
+        c = s & -s;
+        r = s + c;
+        s = (((r ^ s) >> 2) / c) | r;
+    }
+
+    return degree;
+}
+
+int circulant_neighbours(struct generator* gen, int v, int* out) {
+    int n = gen->n;
+    int degree = 0;
+    int i, j, u;
+
+    for(i = 0; i < gen->jump_count; i++) {
+        j = (gen->jumps[i] % n + n) % n;
+        u = (int) (((long) v + j) % n);
+        out[degree++] = u;
+        u = (int) (((long) v - j + n) % n);
+        out[degree++] = u;
+    }
+
+    // drop loops and repeats, such as jumps of n / 2
+    qsort(out, degree, sizeof(int), compare_ints);
+    for(i = j = 0; i < degree; i++) {
+        if(out[i] != v && (!j || out[i] != out[j - 1])) {
+            out[j++] = out[i];
+        }
+    }
+    return j;
+}
+
+int geometric_neighbours(struct generator* gen, int v, int* out) {
+    int cells = gen->cells;
+    int cx = grid_cell(gen->x[v], cells);
+    int cy = grid_cell(gen->y[v], cells);
+    double r2 = gen->radius * gen->radius;
+    double dx, dy;
+    int degree = 0;
+    int a, b, c, u;
+
+    for(a = cx - 1; a <= cx + 1; a++) {
+        for(b = cy - 1; b <= cy + 1; b++) {
+            if(a < 0 || a >= cells || b < 0 || b >= cells) {
+                continue;
+            }
+            c = a * cells + b;
+            for(u = gen->cell_start[c]; u < gen->cell_start[c + 1]; u++) {
+                dx = gen->x[u] - gen->x[v];
+                dy = gen->y[u] - gen->y[v];
+                if(u != v && dx * dx + dy * dy <= r2) {
+                    out[degree++] = u;
+                }
+            }
+        }
+    }
+
+    qsort(out, degree, sizeof(int), compare_ints);
+    return degree;
+}
+
+int list_neighbours(struct generator* gen, int v, int* out) {
+    int degree = gen->start[v + 1] - gen->start[v];
+    memcpy(out, gen->nbr + gen->start[v], degree * sizeof(int));
+    return degree;
+}
+
+// List the k-subsets of n for a Kneser graph, in increasing order as integers.
+void setup_kneser(struct generator* gen, struct arena* arena) {
+    int n = gen->kneser_n;
+    int k = gen->kneser_k;
+    double vertices = 1;
+    double degree = 1;
+    uint64_t s, c, r;
+    int i, a, b;
+
+    for(i = 0; i < k; i++) {
+        vertices = vertices * (n - i) / (i + 1);
+        degree = degree * (n - k - i) / (i + 1);
+    }
+    if(vertices > INT_MAX) {
+        generate_error("the Kneser graph has too many vertices");
+    }
+
+    gen->n = (int) (vertices + 0.5);
+    gen->max_degree = degree > 0 ? (int) (degree + 0.5) : 0;
+    gen->subsets = arena_alloc(arena, (gen->n + 1) * sizeof(uint64_t));
+
+    // every entry fits in 64 bits as a < 64, and each term of a rank is at most the rank,
+    // which fits in an int as the count does
+    gen->binomial = arena_zalloc(arena, 64 * sizeof(*gen->binomial));
+    for(a = 0; a < 64; a++) {
+        gen->binomial[a][0] = 1;
+        for(b = 1; b <= a && b <= k; b++) {
+            gen->binomial[a][b] = gen->binomial[a - 1][b - 1] + (b < a ? gen->binomial[a - 1][b] : 0);
+        }
+    }
+
+    // Gosper's hack steps through the k-subsets in increasing order
+    s = ((uint64_t) 1 << k) - 1;
+    for(i = 0; i < gen->n; i++) {
+        gen->subsets[i] = s;
+        c = s & -s;
+        r = s + c;
+        s = (((r ^ s) >> 2) / c) | r;
+    }
+}
+
+// Place the points of a geometric graph in a grid of cells at least the radius wide,
+// numbering them cell by cell so neighbours have nearby numbers.
+void setup_geometric(struct generator* gen, struct arena* arena) {
+    int n = gen->n;
+    double side;
+    double* x;
+    double* y;
+    int* cell;
+    int* fill;
+    int i, c, cells, count;
+
+    if(gen->radius <= 0) {
+        generate_error("the radius must be positive");
+    }
+    side = 1 / gen->radius;
+    cells = side < 1 ? 1 : side > INT_MAX ? INT_MAX : (int) side;
+    // more cells than points only adds empty cells to scan, and the cells are numbered
+    // with ints, so the count must fit in one
+    while(((double) cells * cells > 4.0 * n + 1 || (double) cells * cells >= INT_MAX) && cells > 1) {
+        cells /= 2;
+    }
+    gen->cells = cells;
+    count = cells * cells;
+
+    x = arena_alloc(arena, n * sizeof(double));
+    y = arena_alloc(arena, n * sizeof(double));
+    cell = arena_alloc(arena, n * sizeof(int));
+    gen->cell_start = arena_zalloc(arena, (count + 1) * sizeof(int));
+    for(i = 0; i < n; i++) {
+        x[i] = uniform();
+        y[i] = uniform();
+        cell[i] = grid_cell(x[i], cells) * cells + grid_cell(y[i], cells);
+        gen->cell_start[cell[i] + 1]++;
+    }
+    for(c = 0; c < count; c++) {
+        gen->cell_start[c + 1] += gen->cell_start[c];
+    }
+
+    fill = arena_alloc(arena, count * sizeof(int));
+    memcpy(fill, gen->cell_start, count * sizeof(int));
+    gen->x = arena_alloc(arena, n * sizeof(double));
+    gen->y = arena_alloc(arena, n * sizeof(double));
+    for(i = 0; i < n; i++) {
+        gen->x[fill[cell[i]]] = x[i];
+        gen->y[fill[cell[i]]++] = y[i];
+    }
+
+    // the degree is not known ahead, so leave room for every vertex
+    gen->max_degree = n;
+}
+
+// Generate G(n, p) in O(n + m) time by skipping over the missing edges, as Batagelj and Brandes.
+void generate_gnp(struct generator* gen, struct arena* arena, double p) {
+    struct edges edges = { NULL, NULL, 0, 0 };
+    long long v = 1;
+    long long w = -1;
+    double skip;
+
+    if(p < 0 || p > 1) {
+        generate_error("p must be between 0 and 1");
+    }
+
+    // edges v w with w < v, in increasing order of v then w
+    while(p > 0 && v < gen->n) {
+        skip = p == 1 ? 0 : floor(log(1 - uniform()) / log(1 - p));
+        w += 1 + (skip > (double) LLONG_MAX / 2 ? LLONG_MAX / 2 : (long long) skip);
+        while(w >= v && v < gen->n) {
+            w -= v;
+            v++;
+        }
+        if(v < gen->n) {
+            add_edge(&edges, v, w);
+        }
+    }
+
+    build_lists(gen, arena, &edges);
+}
+
+// Generate a Chung-Lu graph, with an edge between u and v with chance w_u w_v / sum w,
+// the weights following a power law with the given exponent. Edges are found in O(n + m)
+// time by skipping as for G(n, p), as Miller and Hagberg.
+void generate_powerlaw(struct generator* gen, struct arena* arena, double average, double exponent) {
+    struct edges edges = { NULL, NULL, 0, 0 };
+    int n = gen->n;
+    double* weight;
+    double total = 0;
+    double p, q, scale, skip;
+    long long v;
+    int u;
+
+    if(exponent <= 2 || average <= 0) {
+        generate_error("powerlaw graphs need an exponent above 2 and a positive average degree");
+    }
+
+    // decreasing weights, so vertex 0 has the highest expected degree
+    weight = arena_alloc(arena, (n + 1) * sizeof(double));
+    for(u = 0; u < n; u++) {
+        weight[u] = pow(u + 1, -1 / (exponent - 1));
+        total += weight[u];
+    }
+    scale = n ? average * n / total : 0;
+    total = 0;
+    for(u = 0; u < n; u++) {
+        weight[u] *= scale;
+        total += weight[u];
+    }
+
+    // edges u v with u < v, in increasing order of u then v
+    for(u = 0; u + 1 < n; u++) {
+        v = u + 1;
+        p = fmin(weight[u] * weight[v] / total, 1);
+        while(v < n && p > 0) {
+            if(p < 1) {
+                skip = floor(log(1 - uniform()) / log(1 - p));
+                v = skip < n ? v + (long long) skip : n;
+            }
+            if(v < n) {
+                // the chance falls as v grows, so accept with the ratio to the chance skipped at
+                q = fmin(weight[u] * weight[v] / total, 1);
+                if(uniform() < q / p) {
+                    add_edge(&edges, u, v);
+                }
+                p = q;
+                v++;
+            }
+        }
+    }
+
+    build_lists(gen, arena, &edges);
+}
+
+// Keep an edge found by a random family.
+void add_edge(struct edges* edges, int u, int v) {
+    if(edges->count == edges->capacity) {
+        edges->capacity = edges->capacity ? 2 * edges->capacity : 1 << 16;
+        edges->u = realloc(edges->u, edges->capacity * sizeof(int));
+        edges->v = realloc(edges->v, edges->capacity * sizeof(int));
+        if(edges->u == NULL || edges->v == NULL) {
+            printf("Out of memory allocating %zu edges.\n", edges->capacity);
+            exit(EXIT_FAILURE);
+        }
+    }
+    edges->u[edges->count] = u;
+    edges->v[edges->count++] = v;
+}
+
+// Sort the edges of a random family into lists, freeing them.
+void build_lists(struct generator* gen, struct arena* arena, struct edges* edges) {
+    int n = gen->n;
+    int* fill;
+    size_t i;
+    int v;
+
+    if(edges->count > INT_MAX / 2) {
+        generate_error("the graph has too many edges");
+    }
+
+    gen->start = arena_zalloc(arena, (n + 1) * sizeof(int));
+    gen->nbr = arena_alloc(arena, (2 * edges->count + 1) * sizeof(int));
+    for(i = 0; i < edges->count; i++) {
+        gen->start[edges->u[i] + 1]++;
+        gen->start[edges->v[i] + 1]++;
+    }
+    gen->max_degree = 0;
+    for(v = 0; v < n; v++) {
+        if(gen->start[v + 1] > gen->max_degree) {
+            gen->max_degree = gen->start[v + 1];
+        }
+        gen->start[v + 1] += gen->start[v];
+    }
+
+    fill = arena_alloc(arena, (n + 1) * sizeof(int));
+    memcpy(fill, gen->start, n * sizeof(int));
+    for(i = 0; i < edges->count; i++) {
+        gen->nbr[fill[edges->u[i]]++] = edges->v[i];
+        gen->nbr[fill[edges->v[i]]++] = edges->u[i];
+    }
+
+    // both families find the edges in an order that fills each list in increasing
+    // order, checked here so a list is only sorted if that ever changes
+    for(v = 0; v < n; v++) {
+        int degree = gen->start[v + 1] - gen->start[v];
+        int* list = gen->nbr + gen->start[v];
+        int k;
+        for(k = 1; k < degree && list[k - 1] < list[k]; k++) {
+        }
+        if(k < degree) {
+            qsort(list, degree, sizeof(int), compare_ints);
+        }
+    }
+
+    gen->entries = 2 * edges->count;
+    gen->neighbours = list_neighbours;
+    free(edges->u);
+    free(edges->v);
+}
+
+// Find every list, as binary output needs them before it can start.
+void build_all_lists(struct generator* gen, struct arena* arena) {
+    int n = gen->n;
+    size_t entries = 0;
+    size_t capacity;
+    int* out;
+    int v, degree;
+
+    if(gen->neighbours == list_neighbours) {
+        return;
+    }
+
+    out = arena_alloc(arena, (gen->max_degree + 1) * sizeof(int));
+    gen->start = arena_alloc(arena, (n + 1) * sizeof(int));
+    capacity = gen->entries ? gen->entries : (size_t) n * 4 + 1;
+    gen->nbr = NULL;
+    for(v = 0; v <= n; v++) {
+        degree = v < n ? gen->neighbours(gen, v, out) : 0;
+        if(entries + degree > INT_MAX) {
+            generate_error("the graph has too many edges");
+        }
+        if(gen->nbr == NULL || entries + degree > capacity) {
+            while(entries + degree > capacity) {
+                capacity *= 2;
+            }
+            gen->nbr = realloc(gen->nbr, capacity * sizeof(int));
+            if(gen->nbr == NULL) {
+                printf("Out of memory allocating %zu neighbours.\n", capacity);
+                exit(EXIT_FAILURE);
+            }
+        }
+        gen->start[v] = entries;
+        memcpy(gen->nbr + entries, out, degree * sizeof(int));
+        entries += degree;
+    }
+    gen->entries = entries;
+
+    // the lists are kept in the arena like those of gnp and powerlaw
+    int* nbr = arena_alloc(arena, (entries + 1) * sizeof(int));
+    memcpy(nbr, gen->nbr, entries * sizeof(int));
+    free(gen->nbr);
+    gen->nbr = nbr;
+    gen->neighbours = list_neighbours;
+}
+
+// Write a graph in the text format, one vertex at a time.
+void write_text(struct generator* gen, struct arena* arena) {
+    int* out = arena_alloc(arena, (gen->max_degree + 1) * sizeof(int));
+    int v, i, degree;
+
+    output_int(gen->n, 0);
+    output_char('\n');
+    for(v = 0; v < gen->n; v++) {
+        degree = gen->neighbours(gen, v, out);
+        output_int(degree, 0);
+        for(i = 0; i < degree; i++) {
+            output_char(' ');
+            output_int(out[i], 0);
+        }
+        output_char('\n');
+    }
+}
+
+// Returns the cell of a grid coordinate in [0, 1), cells to a side.
+int grid_cell(double coordinate, int cells) {
+    int c = (int) (coordinate * cells);
+    return c < cells ? c : cells - 1;
+}
+
+// Returns a uniform number in [0, 1).
+double uniform() {
+    return (next_random() >> 11) * 0x1.0p-53;
+}
+
+int compare_ints(const void* a, const void* b) {
+    return (*(const int*) a > *(const int*) b) - (*(const int*) a < *(const int*) b);
+}
+
+// Report invalid parameters and exit.
+void generate_error(const char* problem) {
+    printf("Invalid parameters, %s.\n", problem);
+    exit(EXIT_FAILURE);
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// This program calculates a minimal dominating set for a graph given a heuristic and a time limit
+// The heuristic for this program is max-coverage greedy with random tie-breaking.
+// Graphs are provided through standard input in the format specified by assignment 2.
+// Storage is sized for each graph as it is read, so there is no limit on its size.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/pipeline.h"
+#include "../common/timer.h"
+#include "../common/options.h"
+#include "../common/stats.h"
+#include "../common/dom_set.h"
+#include "../common/random.h"
+#include "../common/greedy.h"
+#include "../common/lower_bound.h"
+#include "../common/local_search.h"
+
+// Verbose output flag
+int verbose;
+
+int main(int argc, char* argv[]) {
+    uint64_t seed;
+    if(!parse_options(argc, argv, 3, &seed, &job_budget)) {
+         printf("Usage %s <maximum number of seconds per graph> <verbose> [--seed <seed>] [--budget <seconds for all graphs>] [--stats]\n", argv[0]);
+         return EXIT_FAILURE;
+    }
+    max_second = atoi(argv[1]);
+    verbose = atoi(argv[2]);
+    start_job();
+
+    struct pipeline pipeline; // reads and prints the graphs around the one being solved
+    struct pipeline_slot* slot; // the graph being solved and its storage
+    struct graph G; // compressed adjacency matrix form of a graph
+    int* num_choice; // number of times it could be dominated
+    int* num_dom; // number of times it is dominated
+    int size; // size of the current dominating set
+    int* dom; // current dominating set
+    int* start; // closed neighbourhood lists, see closed_neighbourhoods
+    int* nbr;
+    struct greedy greedy; // greedy state
+    int* picks; // members of the greedy set in the order they were picked
+    int* p;
+
+    int* min_dom; // minimum dominating set
+    int min_size; // size of minimum dominating set found so far
+    int bound; // no dominating set is smaller than this
+    double time_limit; // seconds allowed for the current graph
+
+    int i;
+    pipeline_start(&pipeline, verbose);
+    while((slot = pipeline_next(&pipeline)) != NULL) {
+        G = slot->G;
+        time_limit = graph_time_limit(slot->start, slot->end);
+        bound = lower_bound(&G, &slot->arena);
+
+        num_choice = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+        num_dom = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+        p = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+        dom = arena_alloc(&slot->arena, G.m * sizeof(int));
+        min_dom = arena_zalloc(&slot->arena, G.m * sizeof(int));
+
+        picks = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+        closed_neighbourhoods(&G, &slot->arena, &start, &nbr);
+        greedy_init(&greedy, G.vertex_count, start, nbr, &slot->arena);
+
+        // every vertex is a dominating set to start with
+        min_size = G.vertex_count;
+        for(i = 0; i < G.vertex_count; i++) {
+            ADD_ELEMENT(min_dom, i);
+        }
+
+        // every graph gets the same stream, so its result does not depend on the graphs before it
+        seed_random(seed, 0);
+        start_timer();
+        stats_start(G.vertex_count);
+        do {
+            size = greedy_dom_set(&greedy, picks, dom);
+            if(size < min_size) {
+                min_size = size;
+                memcpy(min_dom, dom, G.m * sizeof(int));
+                stats_found(size);
+            }
+
+            // drop the members the greedy set does not need
+            greedy_order(&greedy, picks, size, p);
+            size = evaluate(&G, p, num_choice, num_dom, dom);
+            stats_pass(1);
+
+            if(size < min_size) {
+                min_size = size;
+                memcpy(min_dom, dom, G.m * sizeof(int));
+                stats_found(size);
+            }
+        } while(min_size > bound && !out_of_time(LS_FRACTION * time_limit));
+
+        min_size = local_search(&G, min_dom, min_size, time_limit, bound, NULL);
+
+        stats_report(slot->graph_num, G.vertex_count, min_size, bound);
+        pipeline_write(&pipeline, slot, min_size, bound, min_dom);
+    }
+
+    pipeline_finish(&pipeline);
+    return EXIT_SUCCESS;
+}
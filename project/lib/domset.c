@@ -0,0 +1,764 @@
+#include <limits.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The library of domset.h, built from the same code as the programs.
+// Compile this file alone and link it with the program using the library:
+//   gcc -O2 -fvisibility=hidden -c domset.c
+//   objcopy --localize-hidden domset.o
+//   gcc main.c domset.o
+// The flag hides everything but the functions of domset.h, and objcopy makes the hidden
+// symbols local, so the common code cannot clash with the program's own functions and
+// globals. Built as a shared library, gcc -O2 -fvisibility=hidden -shared -fPIC domset.c,
+// it exports only domset.h.
+//
+// The common code exits when it runs out of memory unless arena_out_of_memory is set,
+// so every call that allocates sets it to its own jmp_buf first and turns the jump into
+// DS_ERROR_MEMORY. The timer, random numbers and jmp_buf are per thread, and stats.h
+// counts nothing unless report_stats is set, which the library never does.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/timer.h"
+#include "../common/stats.h"
+#include "../common/dom_set.h"
+#include "../common/small.h"
+#include "../common/random.h"
+#include "../common/bitslice.h"
+#include "../common/bfs.h"
+#include "../common/greedy.h"
+#include "../common/lower_bound.h"
+#include "../common/local_search.h"
+
+#include "domset.h"
+
+// Longest message kept for ds_message.
+#define DS_MESSAGE_SIZE 160
+
+struct ds_context {
+    struct arena graph_arena; // the loaded graph, reset by each load
+    struct arena work_arena; // the buffers of one call, reset by the next
+    struct arena search_arena; // the local search's, held here so a jump out of the search frees it
+    struct graph G;
+    int loaded; // 1 once a graph has been loaded and validated
+    int bound; // lower bound for the loaded graph, -1 until it is found
+
+    // lists parsed by ds_load_text, kept from one graph to the next
+    int* text_start;
+    int* text_nbr;
+    size_t start_capacity;
+    size_t nbr_capacity;
+
+    char message[DS_MESSAGE_SIZE];
+};
+
+int ds_error(struct ds_context*, int, const char*, ...);
+int ds_reserve(int**, size_t*, size_t);
+int ds_parse_int(const char*, size_t, size_t*, int*);
+int ds_store(struct ds_context*, int, const int*, const int*);
+int ds_bound(struct ds_context*);
+int ds_solve(struct ds_context*, int, double, uint64_t, int*, int*);
+int ds_search(struct ds_context*, double, int*, int*);
+int ds_certify(struct ds_context*, const int*, int);
+int ds_set_list(struct graph*, int*, int*);
+
+// Create a context with no graph loaded.
+//
+// Returns the context, or NULL if out of memory.
+struct ds_context* ds_create(void) {
+    struct ds_context* ctx = calloc(1, sizeof(struct ds_context));
+    if(ctx == NULL) {
+        return NULL;
+    }
+    arena_init(&ctx->graph_arena);
+    arena_init(&ctx->work_arena);
+    arena_init(&ctx->search_arena);
+    ctx->bound = -1;
+    return ctx;
+}
+
+// Free a context and everything it holds. NULL is ignored.
+void ds_destroy(struct ds_context* ctx) {
+    if(ctx == NULL) {
+        return;
+    }
+    arena_free(&ctx->graph_arena);
+    arena_free(&ctx->work_arena);
+    arena_free(&ctx->search_arena);
+    free(ctx->text_start);
+    free(ctx->text_nbr);
+    free(ctx);
+}
+
+// Load and validate a graph given as neighbour lists, replacing the graph loaded before.
+// The lists are copied, so they may be freed once this returns.
+// Parameters:
+//   ctx: the context.
+//   vertex_count: the number of vertices.
+//   start: the neighbours of v are nbr[start[v]] to nbr[start[v + 1] - 1], start[0] is 0.
+//   nbr: the neighbour lists, in any order within a list.
+//
+// Returns DS_OK, or the error that makes the graph invalid, and then no graph is loaded.
+int ds_load(struct ds_context* ctx, int vertex_count, const int* start, const int* nbr) {
+    jmp_buf fail;
+    int status;
+
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    ctx->loaded = 0;
+    ctx->bound = -1;
+    if(vertex_count < 0) {
+        return ds_error(ctx, DS_ERROR_VERTEX_COUNT, "negative vertex count %d", vertex_count);
+    }
+    if(start == NULL || (vertex_count > 0 && start[vertex_count] > 0 && nbr == NULL)) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no neighbour lists");
+    }
+
+    if(setjmp(fail)) {
+        arena_out_of_memory = NULL;
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory loading the graph");
+    }
+    arena_out_of_memory = &fail;
+    arena_reset(&ctx->graph_arena);
+    status = ds_store(ctx, vertex_count, start, nbr);
+    arena_out_of_memory = NULL;
+    return status;
+}
+
+// Load and validate the next graph of a text in the format read by the programs,
+// replacing the graph loaded before.
+// Parameters:
+//   ctx: the context.
+//   text: the text, which need not end with a null.
+//   length: the number of bytes in text.
+//   used: if not NULL, a location to store the number of bytes up to the end of the
+//         graph, so the next graph starts at text + used.
+//
+// Returns DS_OK, DS_END if only white space is left, or the error that makes the graph
+// invalid, and then no graph is loaded.
+int ds_load_text(struct ds_context* ctx, const char* text, size_t length, size_t* used) {
+    size_t pos = 0;
+    size_t entries = 0;
+    int n, v, i, degree;
+
+    if(used != NULL) {
+        *used = 0;
+    }
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    ctx->loaded = 0;
+    ctx->bound = -1;
+    if(text == NULL && length) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no text");
+    }
+
+    while(pos < length && (text[pos] == ' ' || (text[pos] >= '\t' && text[pos] <= '\r'))) {
+        pos++;
+    }
+    if(pos == length) {
+        if(used != NULL) {
+            *used = pos;
+        }
+        return DS_END;
+    }
+
+    if(!ds_parse_int(text, length, &pos, &n)) {
+        return ds_error(ctx, DS_ERROR_FORMAT, "failed to read the vertex count");
+    }
+    if(n < 0) {
+        return ds_error(ctx, DS_ERROR_VERTEX_COUNT, "negative vertex count %d", n);
+    }
+    if(!ds_reserve(&ctx->text_start, &ctx->start_capacity, (size_t) n + 1)) {
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory reading %d vertices", n);
+    }
+
+    for(v = 0; v < n; v++) {
+        ctx->text_start[v] = entries;
+        if(!ds_parse_int(text, length, &pos, &degree)) {
+            return ds_error(ctx, DS_ERROR_FORMAT, "failed to read the degree of vertex %d", v);
+        }
+        // checked here too so a bad degree is not allocated for
+        if(degree < 0 || degree > n - 1) {
+            return ds_error(ctx, DS_ERROR_DEGREE, "degree %d of vertex %d is not in the range [0, %d]",
+                degree, v, n - 1);
+        }
+        if(entries + degree > INT_MAX) {
+            return ds_error(ctx, DS_ERROR_DEGREE, "vertex %d takes the lists past %d entries", v, INT_MAX);
+        }
+        if(!ds_reserve(&ctx->text_nbr, &ctx->nbr_capacity, entries + degree)) {
+            return ds_error(ctx, DS_ERROR_MEMORY, "out of memory reading vertex %d", v);
+        }
+        for(i = 0; i < degree; i++) {
+            if(!ds_parse_int(text, length, &pos, &ctx->text_nbr[entries + i])) {
+                return ds_error(ctx, DS_ERROR_FORMAT, "failed to read neighbour %d of vertex %d", i, v);
+            }
+        }
+        entries += degree;
+    }
+    ctx->text_start[n] = entries;
+
+    if(used != NULL) {
+        *used = pos;
+    }
+    return ds_load(ctx, n, ctx->text_start, ctx->text_nbr);
+}
+
+// Returns the number of vertices of the loaded graph, or -1 if none is loaded.
+int ds_vertex_count(struct ds_context* ctx) {
+    return ctx != NULL && ctx->loaded ? ctx->G.vertex_count : -1;
+}
+
+// Find a lower bound on the size of a dominating set of the loaded graph, see lower_bound.
+// Parameters:
+//   ctx: the context.
+//   bound: a location to store the bound.
+//
+// Returns DS_OK or an error.
+int ds_lower_bound(struct ds_context* ctx, int* bound) {
+    jmp_buf fail;
+
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    if(!ctx->loaded || bound == NULL) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, ctx->loaded ? "no location for the bound" : "no graph loaded");
+    }
+
+    if(setjmp(fail)) {
+        arena_out_of_memory = NULL;
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory finding the lower bound");
+    }
+    arena_out_of_memory = &fail;
+    arena_reset(&ctx->work_arena);
+    *bound = ds_bound(ctx);
+    arena_out_of_memory = NULL;
+    return DS_OK;
+}
+
+// Find a small dominating set of the loaded graph with a heuristic: restarts of the
+// include/exclude pass on the method's orderings, then the local search, as the
+// programs do. With seconds 0 and the same seed the set is the one the program finds;
+// with a time limit the number of restarts depends on the clock, so runs may differ.
+// Parameters:
+//   ctx: the context.
+//   method: DS_RANDOM, DS_BFS or DS_GREEDY.
+//   seconds: the time limit, 0 for a single pass.
+//   seed: the seed of the random numbers.
+//   set: a location to store the members in increasing order, room for every vertex.
+//   size: a location to store the size of the set.
+//
+// Returns DS_OK or an error.
+int ds_heuristic(struct ds_context* ctx, int method, double seconds, uint64_t seed, int* set, int* size) {
+    jmp_buf fail;
+    int status;
+
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    if(!ctx->loaded) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no graph loaded");
+    }
+    if(method < DS_RANDOM || method > DS_GREEDY) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "unknown method %d", method);
+    }
+    if(!(seconds >= 0) || set == NULL || size == NULL) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "negative time limit or no location for the set");
+    }
+
+    if(setjmp(fail)) {
+        arena_out_of_memory = NULL;
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory in the heuristic");
+    }
+    arena_out_of_memory = &fail;
+    status = ds_solve(ctx, method, seconds, seed, set, size);
+    arena_out_of_memory = NULL;
+    return status;
+}
+
+// Find a minimum dominating set of the loaded graph with the exact search of assignment 2,
+// started from a greedy set and stopped early at the lower bound.
+// Parameters:
+//   ctx: the context.
+//   seconds: the time limit, 0 for none.
+//   set: a location to store the members in increasing order, room for every vertex.
+//   size: a location to store the size of the set.
+//
+// Returns DS_OK if the set is a minimum, DS_TIMEOUT if the time limit passed first and
+// the set is the smallest found, or an error.
+int ds_exact(struct ds_context* ctx, double seconds, int* set, int* size) {
+    jmp_buf fail;
+    int status;
+
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    if(!ctx->loaded) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no graph loaded");
+    }
+    if(!(seconds >= 0) || set == NULL || size == NULL) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "negative time limit or no location for the set");
+    }
+
+    if(setjmp(fail)) {
+        arena_out_of_memory = NULL;
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory in the exact search");
+    }
+    arena_out_of_memory = &fail;
+    status = ds_search(ctx, seconds, set, size);
+    arena_out_of_memory = NULL;
+    return status;
+}
+
+// Check a certificate: that a set dominates the loaded graph.
+// Parameters:
+//   ctx: the context.
+//   set: the members.
+//   size: the number of members.
+//
+// Returns DS_OK if the set is a dominating set, DS_ERROR_NOT_DOMINATING if a vertex
+// is not dominated, DS_ERROR_VERTEX if a member is out of range or repeated, or an error.
+int ds_check(struct ds_context* ctx, const int* set, int size) {
+    jmp_buf fail;
+    int status;
+
+    if(ctx == NULL) {
+        return DS_ERROR_ARGUMENT;
+    }
+    if(!ctx->loaded) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no graph loaded");
+    }
+    if(size < 0 || (size > 0 && set == NULL)) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "no set of size %d", size);
+    }
+
+    if(setjmp(fail)) {
+        arena_out_of_memory = NULL;
+        return ds_error(ctx, DS_ERROR_MEMORY, "out of memory checking the set");
+    }
+    arena_out_of_memory = &fail;
+    status = ds_certify(ctx, set, size);
+    arena_out_of_memory = NULL;
+    return status;
+}
+
+// Returns a description of the last error of the context, empty if there was none.
+const char* ds_message(struct ds_context* ctx) {
+    return ctx != NULL ? ctx->message : "";
+}
+
+// Returns the name of a status code.
+const char* ds_status_string(int status) {
+    switch(status) {
+    case DS_OK: return "ok";
+    case DS_TIMEOUT: return "time limit reached";
+    case DS_END: return "end of text";
+    case DS_ERROR_MEMORY: return "out of memory";
+    case DS_ERROR_ARGUMENT: return "invalid argument";
+    case DS_ERROR_FORMAT: return "improper graph format";
+    case DS_ERROR_VERTEX_COUNT: return "invalid vertex count";
+    case DS_ERROR_DEGREE: return "invalid degree";
+    case DS_ERROR_VERTEX: return "invalid vertex";
+    case DS_ERROR_MULTIPLE_EDGE: return "multiple edges";
+    case DS_ERROR_LOOP: return "loop";
+    case DS_ERROR_ASYMMETRIC: return "asymmetric adjacency";
+    case DS_ERROR_NOT_DOMINATING: return "not a dominating set";
+    }
+    return "unknown status";
+}
+
+// Note an error in the context's message.
+// Parameters:
+//   ctx: the context.
+//   status: the error.
+//   format: the message, as for printf.
+//
+// Returns status.
+int ds_error(struct ds_context* ctx, int status, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(ctx->message, DS_MESSAGE_SIZE, format, args);
+    va_end(args);
+    return status;
+}
+
+// Grow a buffer kept from one call to the next.
+// Parameters:
+//   buffer: the buffer, reallocated if too small.
+//   capacity: the number of ints it holds.
+//   needed: the number of ints needed.
+//
+// Returns 1, or 0 if out of memory, leaving the buffer as it was.
+int ds_reserve(int** buffer, size_t* capacity, size_t needed) {
+    if(needed <= *capacity) {
+        return 1;
+    }
+
+    int* grown = realloc(*buffer, 2 * needed * sizeof(int));
+    if(grown == NULL) {
+        return 0;
+    }
+    *buffer = grown;
+    *capacity = 2 * needed;
+    return 1;
+}
+
+// Parse an integer as input_int does: white space, an optional sign, then decimal digits.
+// Parameters:
+//   text: the text.
+//   length: the number of bytes in text.
+//   pos: the index of the next byte, moved past the integer.
+//   value: a location to store the integer.
+//
+// Returns 1 if an integer that fits in an int was read and 0 otherwise.
+int ds_parse_int(const char* text, size_t length, size_t* pos, int* value) {
+    size_t i = *pos;
+    long long v = 0;
+    int negative = 0;
+
+    while(i < length && (text[i] == ' ' || (text[i] >= '\t' && text[i] <= '\r'))) {
+        i++;
+    }
+    if(i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i++] == '-';
+    }
+    if(i == length || text[i] < '0' || text[i] > '9') {
+        return 0;
+    }
+    while(i < length && text[i] >= '0' && text[i] <= '9') {
+        v = v * 10 + (text[i++] - '0');
+        if(v > (long long) INT_MAX + 1) {
+            return 0;
+        }
+    }
+    if(!negative && v > INT_MAX) {
+        return 0;
+    }
+
+    *pos = i;
+    *value = negative ? -v : v;
+    return 1;
+}
+
+// Copy, check and store neighbour lists as the context's graph, see ds_load.
+// The checks are those of read_graph and check_graph.
+//
+// Returns DS_OK or the error that makes the graph invalid.
+int ds_store(struct ds_context* ctx, int n, const int* start, const int* nbr) {
+    struct graph* G = &ctx->G;
+    struct arena* arena = &ctx->graph_arena;
+    int v, u, i, it, degree;
+    size_t entries = 0;
+
+    if(start[0] != 0) {
+        return ds_error(ctx, DS_ERROR_ARGUMENT, "the first list starts at %d, not 0", start[0]);
+    }
+
+    G->vertex_count = n;
+    G->validated = 0;
+    G->start = arena_alloc(arena, ((size_t) n + 1) * sizeof(int));
+    for(v = 0; v < n; v++) {
+        degree = start[v + 1] - start[v];
+        if(degree < 0 || degree > n - 1) {
+            return ds_error(ctx, DS_ERROR_DEGREE, "degree %d of vertex %d is not in the range [0, %d]",
+                degree, v, n - 1);
+        }
+        G->start[v] = entries;
+        entries += degree;
+    }
+    G->start[n] = entries;
+
+    int* list = arena_alloc(arena, (entries + 1) * sizeof(int));
+    memcpy(list, nbr, entries * sizeof(int));
+    for(v = 0; v < n; v++) {
+        for(i = G->start[v]; i < G->start[v + 1]; i++) {
+            if(list[i] < 0 || list[i] > n - 1) {
+                return ds_error(ctx, DS_ERROR_VERTEX, "neighbour %d of vertex %d is not in the range [0, %d]",
+                    list[i], v, n - 1);
+            }
+            if(list[i] == v) {
+                return ds_error(ctx, DS_ERROR_LOOP, "loop at vertex %d", v);
+            }
+        }
+
+        sort_neighbours(list + G->start[v], G->start[v + 1] - G->start[v]);
+        for(i = G->start[v] + 1; i < G->start[v + 1]; i++) {
+            if(list[i] == list[i - 1]) {
+                return ds_error(ctx, DS_ERROR_MULTIPLE_EDGE, "multiple edges between vertex %d and vertex %d",
+                    v, list[i]);
+            }
+        }
+    }
+
+    store_graph(G, arena, list, entries, 1);
+
+    for(v = 0; v < n; v++) {
+        for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+            if(!adjacent(G, u, v)) {
+                return ds_error(ctx, DS_ERROR_ASYMMETRIC, "vertex %d is a neighbour of vertex %d but not the reverse",
+                    u, v);
+            }
+        }
+    }
+
+    G->validated = 1;
+    ctx->loaded = 1;
+    return DS_OK;
+}
+
+// Returns the lower bound of the loaded graph, finding it in the work arena the first time.
+int ds_bound(struct ds_context* ctx) {
+    if(ctx->bound < 0) {
+        ctx->bound = lower_bound(&ctx->G, &ctx->work_arena);
+    }
+    return ctx->bound;
+}
+
+// The heuristic of ds_heuristic, once its arguments are checked.
+int ds_solve(struct ds_context* ctx, int method, double seconds, uint64_t seed, int* set, int* size) {
+    struct graph* G = &ctx->G;
+    struct arena* arena = &ctx->work_arena;
+    struct greedy greedy;
+    struct bfs bfs;
+    struct bitslice lanes;
+    int n = G->vertex_count;
+    int* start;
+    int* nbr;
+    int* picks;
+    int i, pass_size, min_size, bound;
+
+    arena_reset(arena);
+    bound = ds_bound(ctx);
+
+    int* num_choice = arena_alloc(arena, n * sizeof(int));
+    int* num_dom = arena_alloc(arena, n * sizeof(int));
+    int* p = arena_alloc(arena, n * sizeof(int));
+    int* dom = arena_alloc(arena, G->m * sizeof(int));
+    int* min_dom = arena_zalloc(arena, G->m * sizeof(int));
+    closed_neighbourhoods(G, arena, &start, &nbr);
+    if(method == DS_RANDOM) {
+        bitslice_init(&lanes, n, start, nbr, arena);
+    } else if(method == DS_BFS) {
+        bfs_init(&bfs, n, start, nbr, arena);
+    } else if(method == DS_GREEDY) {
+        picks = arena_alloc(arena, n * sizeof(int));
+        greedy_init(&greedy, n, start, nbr, arena);
+    }
+
+    // every vertex is a dominating set to start with
+    min_size = n;
+    for(i = 0; i < n; i++) {
+        ADD_ELEMENT(min_dom, i);
+    }
+
+    seed_random(seed, 0);
+    start_timer();
+    do {
+        if(method == DS_GREEDY) {
+            pass_size = greedy_dom_set(&greedy, picks, dom);
+            if(pass_size < min_size) {
+                min_size = pass_size;
+                memcpy(min_dom, dom, G->m * sizeof(int));
+            }
+
+            // drop the members the greedy set does not need
+            greedy_order(&greedy, picks, pass_size, p);
+        } else if(method == DS_BFS) {
+            bfs_order(&bfs, p);
+        } else {
+            // 64 orderings at once, as project/random does
+            for(i = 0; i < n; i++) {
+                p[i] = i;
+            }
+            shuffle(n, p);
+        }
+
+        if(method == DS_RANDOM) {
+            pass_size = bitslice_evaluate(&lanes, p, dom);
+        } else {
+            pass_size = evaluate(G, p, num_choice, num_dom, dom);
+        }
+        if(pass_size < min_size) {
+            min_size = pass_size;
+            memcpy(min_dom, dom, G->m * sizeof(int));
+        }
+    } while(min_size > bound && !out_of_time(LS_FRACTION * seconds));
+
+    *size = local_search_in(&ctx->search_arena, G, min_dom, min_size, seconds, bound, NULL);
+    ds_set_list(G, min_dom, set);
+    return DS_OK;
+}
+
+// The exact search of ds_exact, once its arguments are checked.
+// This is min_dom_set of assignment 2 on the closed neighbourhood lists, with an
+// explicit stack so its depth is not limited by the C stack. Vertex level is made
+// blue (left out), then red (put in the set). A branch is cut when a vertex can no
+// longer be dominated, or when even members dominating max_deg new vertices each
+// could not beat the smallest set found. Graphs of at most SMALL_MAX vertices use
+// small_search instead.
+int ds_search(struct ds_context* ctx, double seconds, int* set, int* size) {
+    struct graph* G = &ctx->G;
+    struct arena* arena = &ctx->work_arena;
+    struct greedy greedy;
+    int n = G->vertex_count;
+    int* start;
+    int* nbr;
+    int i, j, v, level, undominated;
+
+    arena_reset(arena);
+    int bound = ds_bound(ctx);
+    closed_neighbourhoods(G, arena, &start, &nbr);
+
+    int* num_choice = arena_alloc(arena, n * sizeof(int)); // members still possible in each closed neighbourhood
+    int* num_dom = arena_alloc(arena, n * sizeof(int)); // members in each closed neighbourhood
+    int* colour = arena_alloc(arena, ((size_t) n + 1) * sizeof(int)); // 0 not tried, 1 blue, 2 red
+    int* p = arena_alloc(arena, n * sizeof(int));
+    int* picks = arena_alloc(arena, n * sizeof(int));
+    int* dom = arena_zalloc(arena, G->m * sizeof(int));
+    int* min_dom = arena_alloc(arena, G->m * sizeof(int));
+
+    // the greedy set, trimmed by the include/exclude pass, is the first to beat
+    seed_random(0, 0);
+    start_timer();
+    greedy_init(&greedy, n, start, nbr, arena);
+    greedy_order(&greedy, picks, greedy_dom_set(&greedy, picks, min_dom), p);
+    int min_size = evaluate(G, p, num_choice, num_dom, min_dom);
+
+    // small graphs are searched on their neighbourhood masks, see small.h
+    if(G->closed != NULL) {
+        int status = small_search(G, seconds, bound, &min_size, min_dom) ? DS_OK : DS_TIMEOUT;
+        *size = min_size;
+        ds_set_list(G, min_dom, set);
+        return status;
+    }
+
+    int max_deg = 1;
+    for(i = 0; i < n; i++) {
+        num_choice[i] = start[i + 1] - start[i];
+        if(num_choice[i] > max_deg) {
+            max_deg = num_choice[i];
+        }
+    }
+    memset(num_dom, 0, n * sizeof(int));
+
+    int size_now = 0;
+    int n_dom = 0;
+    int blocked = 0; // vertices with no possible member left
+    int status = DS_OK;
+
+    level = 0;
+    colour[0] = 0;
+    while(level >= 0 && min_size > bound) {
+        if(!colour[level]) {
+            if(seconds > 0 && out_of_time(seconds)) {
+                status = DS_TIMEOUT;
+                break;
+            }
+
+            undominated = n - n_dom;
+            if(blocked || size_now + (undominated + max_deg - 1) / max_deg >= min_size) {
+                level--;
+            } else if(level == n || !undominated) {
+                min_size = size_now;
+                memcpy(min_dom, dom, G->m * sizeof(int));
+                level--;
+            } else {
+                // make vertex level blue
+                for(j = start[level]; j < start[level + 1]; j++) {
+                    if(!--num_choice[nbr[j]]) {
+                        blocked++;
+                    }
+                }
+                colour[level++] = 1;
+                colour[level] = 0;
+            }
+            continue;
+        }
+
+        v = level;
+        if(colour[v] == 1) {
+            // undo blue, make vertex level red
+            for(j = start[v]; j < start[v + 1]; j++) {
+                if(!num_choice[nbr[j]]++) {
+                    blocked--;
+                }
+                if(!num_dom[nbr[j]]++) {
+                    n_dom++;
+                }
+            }
+            ADD_ELEMENT(dom, v);
+            size_now++;
+            colour[level++] = 2;
+            colour[level] = 0;
+        } else {
+            // undo red
+            for(j = start[v]; j < start[v + 1]; j++) {
+                if(!--num_dom[nbr[j]]) {
+                    n_dom--;
+                }
+            }
+            DEL_ELEMENT(dom, v);
+            size_now--;
+            level--;
+        }
+    }
+
+    *size = min_size;
+    ds_set_list(G, min_dom, set);
+    return status;
+}
+
+// The check of ds_check, once its arguments are checked.
+int ds_certify(struct ds_context* ctx, const int* set, int size) {
+    struct graph* G = &ctx->G;
+    struct arena* arena = &ctx->work_arena;
+    int n = G->vertex_count;
+    int i, it, u, v;
+
+    arena_reset(arena);
+    int* member = arena_zalloc(arena, G->m * sizeof(int));
+    int* dominated = arena_zalloc(arena, n * sizeof(int));
+
+    for(i = 0; i < size; i++) {
+        v = set[i];
+        if(v < 0 || v > n - 1) {
+            return ds_error(ctx, DS_ERROR_VERTEX, "member %d is not in the range [0, %d]", v, n - 1);
+        }
+        if(IS_ELEMENT(member, v)) {
+            return ds_error(ctx, DS_ERROR_VERTEX, "vertex %d is in the set twice", v);
+        }
+        ADD_ELEMENT(member, v);
+
+        dominated[v] = 1;
+        for(it = -1; (u = next_neighbour(G, v, &it)) >= 0;) {
+            dominated[u] = 1;
+        }
+    }
+
+    for(v = 0; v < n; v++) {
+        if(!dominated[v]) {
+            return ds_error(ctx, DS_ERROR_NOT_DOMINATING, "vertex %d is not dominated", v);
+        }
+    }
+    return DS_OK;
+}
+
+// List the members of a set in increasing order.
+// Parameters:
+//   G: the graph.
+//   dom: the set.
+//   set: a location to store the members.
+//
+// Returns the number of members.
+int ds_set_list(struct graph* G, int* dom, int* set) {
+    int v;
+    int size = 0;
+    for(v = -1; (v = next_element(dom, G->m, v)) >= 0;) {
+        set[size++] = v;
+    }
+    return size;
+}
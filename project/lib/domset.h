@@ -0,0 +1,57 @@
+#ifndef DOMSET_H
+#define DOMSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The dominating set solvers as a library: loading and validating graphs, the
+// heuristics, the exact search and checking certificates.
+//
+// Everything a call needs lives in a context from ds_create, which keeps its buffers
+// from one graph to the next. Nothing exits or prints: every call returns a status,
+// and ds_message describes the last error. Contexts share no state, so threads may
+// each use their own at once, but a context must only be used by one thread at a time.
+//
+// A typical use:
+//   struct ds_context* ctx = ds_create();
+//   if(ds_load(ctx, n, start, nbr) == DS_OK && ds_heuristic(ctx, DS_GREEDY, 1, 0, set, &size) == DS_OK) ...
+//   ds_destroy(ctx);
+
+// Status codes. Errors are negative.
+#define DS_OK 0
+#define DS_TIMEOUT 1 // ds_exact stopped at its time limit, the set is the best found
+#define DS_END 2 // ds_load_text found no graph before the end of the text
+#define DS_ERROR_MEMORY -1
+#define DS_ERROR_ARGUMENT -2 // a NULL or out of range argument, or no graph is loaded
+#define DS_ERROR_FORMAT -3 // the text ended inside a graph or held something other than an integer
+#define DS_ERROR_VERTEX_COUNT -4
+#define DS_ERROR_DEGREE -5
+#define DS_ERROR_VERTEX -6 // a vertex number out of range
+#define DS_ERROR_MULTIPLE_EDGE -7
+#define DS_ERROR_LOOP -8
+#define DS_ERROR_ASYMMETRIC -9 // v is a neighbour of u but u is not a neighbour of v
+#define DS_ERROR_NOT_DOMINATING -10 // ds_check found a vertex the set does not dominate
+
+// Orderings for ds_heuristic, as in the programs of the same names.
+#define DS_RANDOM 0
+#define DS_BFS 1
+#define DS_GREEDY 2
+
+struct ds_context;
+
+// The functions the library exports, everything else in it is hidden, see domset.c.
+#define DS_API __attribute__((visibility("default")))
+
+DS_API struct ds_context* ds_create(void);
+DS_API void ds_destroy(struct ds_context*);
+DS_API int ds_load(struct ds_context*, int, const int*, const int*);
+DS_API int ds_load_text(struct ds_context*, const char*, size_t, size_t*);
+DS_API int ds_vertex_count(struct ds_context*);
+DS_API int ds_lower_bound(struct ds_context*, int*);
+DS_API int ds_heuristic(struct ds_context*, int, double, uint64_t, int*, int*);
+DS_API int ds_exact(struct ds_context*, double, int*, int*);
+DS_API int ds_check(struct ds_context*, const int*, int);
+DS_API const char* ds_message(struct ds_context*);
+DS_API const char* ds_status_string(int);
+
+#endif
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// An example of the library in domset.h: it solves every graph on standard input
+// with one of the methods and checks each set before printing a line for it.
+// Only domset.h is included, the common code is compiled into domset.o.
+
+#include "domset.h"
+
+// Bytes read from standard input at a time.
+#define READ_BLOCK (1 << 20)
+
+char* read_all(size_t*);
+
+int main(int argc, char* argv[]) {
+    const char* methods[] = {"random", "bfs", "greedy", "exact"};
+    int method;
+    if(argc != 3) {
+        printf("Usage %s <maximum number of seconds per graph> <random|bfs|greedy|exact>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    for(method = 0; method < 4 && strcmp(argv[2], methods[method]); method++);
+    if(method == 4) {
+        printf("Unknown method %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    double seconds = atof(argv[1]);
+
+    size_t length, pos, used;
+    char* text = read_all(&length);
+    struct ds_context* ctx = ds_create();
+    if(text == NULL || ctx == NULL) {
+        printf("Out of memory reading the input.\n");
+        return EXIT_FAILURE;
+    }
+
+    int* set = NULL;
+    int graph_num, status, n, size, bound;
+    pos = 0;
+    for(graph_num = 1; ; graph_num++) {
+        status = ds_load_text(ctx, text + pos, length - pos, &used);
+        pos += used;
+        if(status == DS_END) {
+            break;
+        }
+        if(status != DS_OK) {
+            printf("*** Error- %s: %s\n", ds_status_string(status), ds_message(ctx));
+            printf("Graph   %5d: BAD GRAPH\n", graph_num);
+            return EXIT_FAILURE;
+        }
+
+        n = ds_vertex_count(ctx);
+        set = realloc(set, (n + 1) * sizeof(int));
+        if(set == NULL) {
+            printf("Out of memory allocating the set.\n");
+            return EXIT_FAILURE;
+        }
+
+        status = ds_lower_bound(ctx, &bound);
+        if(status == DS_OK) {
+            status = method == 3 ? ds_exact(ctx, seconds, set, &size) : ds_heuristic(ctx, method, seconds, 0, set, &size);
+        }
+        if(status >= DS_OK) {
+            status = ds_check(ctx, set, size);
+        }
+        if(status != DS_OK) {
+            printf("Graph   %5d: %s: %s\n", graph_num, ds_status_string(status), ds_message(ctx));
+            return EXIT_FAILURE;
+        }
+
+        printf("%4d %4d   %3d   %3d %3d\n", graph_num, n, size, bound, size - bound);
+    }
+
+    free(set);
+    free(text);
+    ds_destroy(ctx);
+    return EXIT_SUCCESS;
+}
+
+// Read all of standard input.
+// Parameters:
+//   length: a location to store the number of bytes read.
+//
+// Returns the bytes read, or NULL if out of memory.
+char* read_all(size_t* length) {
+    size_t capacity = READ_BLOCK;
+    size_t got;
+    char* text = malloc(capacity);
+    char* grown;
+
+    *length = 0;
+    while(text != NULL && (got = fread(text + *length, 1, capacity - *length, stdin)) > 0) {
+        *length += got;
+        if(*length == capacity) {
+            capacity *= 2;
+            grown = realloc(text, capacity);
+            if(grown == NULL) {
+                free(text);
+            }
+            text = grown;
+        }
+    }
+    return text;
+}
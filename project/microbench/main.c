@@ -0,0 +1,518 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// This program times the kernels the heuristics spend their time in, in isolation,
+// on random graphs and sets of several sizes and densities:
+//   popcount: counting a set, per 32 elements (one longword).
+//   add_element, is_element: adding or testing a random element, per element.
+//   next_element: stepping through the elements of a set, per element found.
+//   evaluate: the include/exclude pass of dom_set.h, per pass over a random ordering.
+//     The lanes64 variant is bitslice.h, 64 passes per call, so also timed per pass.
+//     The small variant is the kernel of small.h, timed only up to SMALL_MAX vertices.
+//   greedy: the max-coverage greedy of greedy.h, per dominating set.
+// The first variant of each set kernel is the code in bitset.h. The others show what
+// a change would gain: 64 bit longwords, shifts or builtins instead of the nauty tables.
+// evaluate is timed on the graph stored both ways, to check DENSE_FACTOR.
+// Times are reported in ns per operation and, on x86, in time stamp counter ticks per
+// operation, which track cycles at the nominal clock rate.
+
+#include "../common/arena.h"
+#include "../common/bitset.h"
+#include "../common/graph.h"
+#include "../common/dom_set.h"
+#include "../common/bitslice.h"
+#include "../common/greedy.h"
+#include "../common/random.h"
+#include "../common/timer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+// Largest number of neighbour list entries in a generated graph, larger graphs are skipped.
+#define MAX_ENTRIES (1 << 24)
+
+// Number of random positions and orderings cycled through, so each call differs.
+#define POSITIONS 4096
+#define ORDERINGS 8
+
+// Everything a kernel needs, built once for each size and density.
+struct bench {
+    int n;
+    double density;
+    int m;
+    int* set; // random set with the given density
+    uint64_t* set64; // the same set in 64 bit longwords, bit 0 the high-order bit
+    int m64;
+    int* scratch; // copies of set and set64 for the add kernels, so the sets keep their density
+    uint64_t* scratch64;
+    int* positions; // POSITIONS random elements
+    struct graph dense; // random graph with the given edge density, as an adjacency matrix
+    struct graph sparse; // the same graph as lists
+    struct graph small; // the matrix with closed neighbourhood masks, if n <= SMALL_MAX
+    int* orders[ORDERINGS]; // random orderings of the vertices
+    int* num_choice;
+    int* num_dom;
+    int* dom;
+    int* picks;
+    struct greedy greedy;
+    struct bitslice lanes;
+    long call; // number of calls so far, to pick positions and orderings
+};
+
+struct kernel {
+    const char* name;
+    const char* variant;
+    long (*run)(struct bench*); // returns the number of operations done
+    int needs_graph; // 1 if it runs on the graph, SMALL_GRAPH if only on a small one
+};
+
+#define SMALL_GRAPH 2
+
+// keeps results live so the compiler cannot drop the work
+volatile long sink;
+
+void build_bench(struct bench*, struct arena*, int, double, int);
+void build_graph(struct graph*, struct arena*, int, int*, int*, int);
+void time_kernel(struct kernel*, struct bench*, double);
+int split_list(const char*, char**, int);
+
+long popcount_table32(struct bench*);
+long popcount_builtin32(struct bench*);
+long popcount_builtin64(struct bench*);
+long add_table32(struct bench*);
+long add_shift32(struct bench*);
+long add_shift64(struct bench*);
+long is_table32(struct bench*);
+long is_shift32(struct bench*);
+long is_shift64(struct bench*);
+long next_clz32(struct bench*);
+long next_clz64(struct bench*);
+long evaluate_dense(struct bench*);
+long evaluate_sparse(struct bench*);
+long evaluate_lanes64(struct bench*);
+long evaluate_small(struct bench*);
+long greedy_lists(struct bench*);
+
+struct kernel kernels[] = {
+    { "popcount", "table32", popcount_table32, 0 },
+    { "popcount", "builtin32", popcount_builtin32, 0 },
+    { "popcount", "builtin64", popcount_builtin64, 0 },
+    { "add_element", "table32", add_table32, 0 },
+    { "add_element", "shift32", add_shift32, 0 },
+    { "add_element", "shift64", add_shift64, 0 },
+    { "is_element", "table32", is_table32, 0 },
+    { "is_element", "shift32", is_shift32, 0 },
+    { "is_element", "shift64", is_shift64, 0 },
+    { "next_element", "clz32", next_clz32, 0 },
+    { "next_element", "clz64", next_clz64, 0 },
+    { "evaluate", "dense", evaluate_dense, 1 },
+    { "evaluate", "sparse", evaluate_sparse, 1 },
+    { "evaluate", "lanes64", evaluate_lanes64, 1 },
+    { "evaluate", "small", evaluate_small, SMALL_GRAPH },
+    { "greedy", "lists", greedy_lists, 1 },
+};
+
+#define KERNEL_COUNT ((int) (sizeof(kernels) / sizeof(kernels[0])))
+
+int main(int argc, char* argv[]) {
+    char* size_list = "128,1024,8192";
+    char* density_list = "0.01,0.1,0.5";
+    char* kernel_list = NULL;
+    double min_time = 0.2;
+    int i;
+
+    for(i = 1; i + 1 < argc; i += 2) {
+        if(!strcmp(argv[i], "--sizes")) {
+            size_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--densities")) {
+            density_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--kernels")) {
+            kernel_list = argv[i + 1];
+        } else if(!strcmp(argv[i], "--time")) {
+            min_time = atof(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if(i != argc) {
+        printf("Usage %s [--sizes <list>] [--densities <list>] [--kernels <list>] [--time <seconds per kernel>]\n"
+            "Lists are separated by commas. Kernels are popcount, add_element, is_element, next_element,\n"
+            "evaluate and greedy.\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char* sizes[64];
+    char* densities[64];
+    char* wanted[64];
+    int size_count = split_list(size_list, sizes, 64);
+    int density_count = split_list(density_list, densities, 64);
+    int wanted_count = kernel_list != NULL ? split_list(kernel_list, wanted, 64) : 0;
+
+    struct arena arena;
+    struct bench b;
+    int s, d, k, j, graph;
+
+    // the graph kernels are only built when one of them is wanted
+    graph = 0;
+    for(k = 0; k < KERNEL_COUNT; k++) {
+        for(j = 0; j < wanted_count && strcmp(wanted[j], kernels[k].name); j++) {
+        }
+        if(kernels[k].needs_graph && (!wanted_count || j < wanted_count)) {
+            graph = 1;
+        }
+    }
+
+    printf("%-14s %-10s %7s %8s %12s %12s\n", "kernel", "variant", "n", "density", "ns/op", HAVE_TSC ? "ticks/op" : "");
+    arena_init(&arena);
+    for(s = 0; s < size_count; s++) {
+        for(d = 0; d < density_count; d++) {
+            build_bench(&b, &arena, atoi(sizes[s]), atof(densities[d]), graph);
+            for(k = 0; k < KERNEL_COUNT; k++) {
+                for(j = 0; j < wanted_count && strcmp(wanted[j], kernels[k].name); j++) {
+                }
+                if((wanted_count && j == wanted_count) || (kernels[k].needs_graph && !b.sparse.vertex_count)
+                        || (kernels[k].needs_graph == SMALL_GRAPH && b.small.closed == NULL)) {
+                    continue;
+                }
+                time_kernel(&kernels[k], &b, min_time);
+            }
+            arena_reset(&arena);
+        }
+    }
+
+    arena_free(&arena);
+    return EXIT_SUCCESS;
+}
+
+// Build the sets and graph for a size and density.
+// Parameters:
+//   b: a location to store them.
+//   arena: the arena to allocate them from.
+//   n: the number of elements or vertices.
+//   density: the chance of each element being in the set and each edge in the graph.
+//   graph: whether to build the graph, left with no vertices if not or if it is too large.
+void build_bench(struct bench* b, struct arena* arena, int n, double density, int graph) {
+    uint64_t threshold = density >= 1 ? UINT64_MAX : (uint64_t) (density * 18446744073709551616.0);
+    int i, j, v;
+
+    memset(b, 0, sizeof(*b));
+    b->n = n;
+    b->density = density;
+    b->m = SET_WORDS(n);
+    b->m64 = (n + 63) / 64;
+    seed_random(1, 0);
+
+    b->set = arena_zalloc(arena, b->m * sizeof(int));
+    b->set64 = arena_zalloc(arena, b->m64 * sizeof(uint64_t));
+    for(i = 0; i < n; i++) {
+        if(next_random() < threshold) {
+            ADD_ELEMENT(b->set, i);
+            b->set64[i >> 6] |= (uint64_t) 1 << (63 - (i & 63));
+        }
+    }
+    b->scratch = arena_alloc(arena, b->m * sizeof(int));
+    b->scratch64 = arena_alloc(arena, b->m64 * sizeof(uint64_t));
+    memcpy(b->scratch, b->set, b->m * sizeof(int));
+    memcpy(b->scratch64, b->set64, b->m64 * sizeof(uint64_t));
+
+    b->positions = arena_alloc(arena, POSITIONS * sizeof(int));
+    for(i = 0; i < POSITIONS; i++) {
+        b->positions[i] = random_below(n);
+    }
+
+    if(!graph || density * n * (n - 1) > MAX_ENTRIES) {
+        return;
+    }
+
+    // pairs are generated in increasing order, so every list comes out sorted
+    int* degree = arena_zalloc(arena, (n + 1) * sizeof(int));
+    int* first = arena_alloc(arena, MAX_ENTRIES / 2 * sizeof(int));
+    int* second = arena_alloc(arena, MAX_ENTRIES / 2 * sizeof(int));
+    size_t edges = 0;
+    for(i = 0; i < n; i++) {
+        for(j = i + 1; j < n && edges < MAX_ENTRIES / 2; j++) {
+            if(next_random() < threshold) {
+                first[edges] = i;
+                second[edges++] = j;
+                degree[i]++;
+                degree[j]++;
+            }
+        }
+    }
+
+    int* start = arena_alloc(arena, (n + 1) * sizeof(int));
+    int* nbr = arena_alloc(arena, (2 * edges + 1) * sizeof(int));
+    int* fill = arena_alloc(arena, n * sizeof(int));
+    start[0] = 0;
+    for(v = 0; v < n; v++) {
+        start[v + 1] = start[v] + degree[v];
+        fill[v] = start[v];
+    }
+    for(i = 0; i < (int) edges; i++) {
+        nbr[fill[first[i]]++] = second[i];
+        nbr[fill[second[i]]++] = first[i];
+    }
+
+    build_graph(&b->dense, arena, n, start, nbr, 1);
+    build_graph(&b->sparse, arena, n, start, nbr, 0);
+    b->small = b->dense;
+    if(n <= SMALL_MAX) {
+        b->small.closed = small_masks(n, start, nbr, arena);
+    }
+
+    for(i = 0; i < ORDERINGS; i++) {
+        b->orders[i] = arena_alloc(arena, n * sizeof(int));
+        for(v = 0; v < n; v++) {
+            b->orders[i][v] = v;
+        }
+        shuffle(n, b->orders[i]);
+    }
+    b->num_choice = arena_alloc(arena, n * sizeof(int));
+    b->num_dom = arena_alloc(arena, n * sizeof(int));
+    b->dom = arena_alloc(arena, b->m * sizeof(int));
+    b->picks = arena_alloc(arena, n * sizeof(int));
+
+    int* closed_start;
+    int* closed_nbr;
+    closed_neighbourhoods(&b->sparse, arena, &closed_start, &closed_nbr);
+    greedy_init(&b->greedy, n, closed_start, closed_nbr, arena);
+    bitslice_init(&b->lanes, n, closed_start, closed_nbr, arena);
+}
+
+// Store a graph given as lists either way, as store_graph does for the way it chooses.
+// Parameters:
+//   G: a location to store the graph.
+//   arena: the arena to allocate the matrix from.
+//   n: the number of vertices.
+//   start: the list offsets.
+//   nbr: the sorted lists.
+//   dense: 1 to store an adjacency matrix, 0 to keep the lists.
+void build_graph(struct graph* G, struct arena* arena, int n, int* start, int* nbr, int dense) {
+    int v, i;
+
+    memset(G, 0, sizeof(*G));
+    G->vertex_count = n;
+    G->m = SET_WORDS(n);
+    G->stride = row_stride(G->m);
+    G->dense = dense;
+    for(v = 0; v < n; v++) {
+        if(start[v + 1] - start[v] > G->max_degree) {
+            G->max_degree = start[v + 1] - start[v];
+        }
+    }
+    if(!dense) {
+        G->start = start;
+        G->nbr = nbr;
+        return;
+    }
+
+    G->rows = arena_zalloc(arena, (size_t) n * G->stride * sizeof(int));
+    for(v = 0; v < n; v++) {
+        for(i = start[v]; i < start[v + 1]; i++) {
+            ADD_ELEMENT(ROW(G, v), nbr[i]);
+        }
+    }
+}
+
+// Run a kernel until it has taken at least min_time seconds and print its time per operation.
+// Parameters:
+//   k: the kernel.
+//   b: the sets and graph to run it on.
+//   min_time: the least number of seconds to run it for.
+void time_kernel(struct kernel* k, struct bench* b, double min_time) {
+    long ops = 0;
+    long batch, i;
+    double start, seconds;
+    uint64_t ticks = 0;
+
+    // once untimed, so the data is in cache as it would be in a search loop
+    k->run(b);
+
+    start = clock_seconds();
+#if HAVE_TSC
+    ticks = __rdtsc();
+#endif
+    // the batches double so reading the clock costs little however short a call is
+    batch = 1;
+    do {
+        for(i = 0; i < batch; i++) {
+            ops += k->run(b);
+        }
+        batch *= 2;
+        seconds = clock_seconds() - start;
+    } while(seconds < min_time);
+#if HAVE_TSC
+    ticks = __rdtsc() - ticks;
+#endif
+
+    printf("%-14s %-10s %7d %8.3f %12.3f", k->name, k->variant, b->n, b->density, ops ? 1e9 * seconds / ops : 0.0);
+    if(HAVE_TSC) {
+        printf(" %12.3f", ops ? (double) ticks / ops : 0.0);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+// Split a comma separated list, the items pointing into a copy of it.
+// Parameters:
+//   list: the list.
+//   items: space for the items.
+//   max: the most items to keep.
+//
+// Returns the number of items.
+int split_list(const char* list, char** items, int max) {
+    int count = 0;
+    char* item;
+    char* copy = strdup(list);
+    if(copy == NULL) {
+        printf("Out of memory copying %s.\n", list);
+        exit(EXIT_FAILURE);
+    }
+    for(item = strtok(copy, ","); item != NULL && count < max; item = strtok(NULL, ",")) {
+        items[count++] = item;
+    }
+    return count;
+}
+
+// set_size, with nauty's byte table.
+long popcount_table32(struct bench* b) {
+    sink += set_size(b->n, b->set);
+    return b->m;
+}
+
+long popcount_builtin32(struct bench* b) {
+    int count = 0;
+    int j;
+    for(j = 0; j < b->m; j++) {
+        count += __builtin_popcount((unsigned int) b->set[j]);
+    }
+    sink += count;
+    return b->m;
+}
+
+long popcount_builtin64(struct bench* b) {
+    int count = 0;
+    int j;
+    for(j = 0; j < b->m64; j++) {
+        count += __builtin_popcountll(b->set64[j]);
+    }
+    sink += count;
+    return b->m;
+}
+
+// ADD_ELEMENT, with nauty's bit table.
+long add_table32(struct bench* b) {
+    int i;
+    for(i = 0; i < POSITIONS; i++) {
+        ADD_ELEMENT(b->scratch, b->positions[i]);
+    }
+    return POSITIONS;
+}
+
+long add_shift32(struct bench* b) {
+    int i, pos;
+    for(i = 0; i < POSITIONS; i++) {
+        pos = b->positions[i];
+        b->scratch[SETWD(pos)] |= 0x80000000u >> SETBT(pos);
+    }
+    return POSITIONS;
+}
+
+long add_shift64(struct bench* b) {
+    int i, pos;
+    for(i = 0; i < POSITIONS; i++) {
+        pos = b->positions[i];
+        b->scratch64[pos >> 6] |= (uint64_t) 1 << (63 - (pos & 63));
+    }
+    return POSITIONS;
+}
+
+// IS_ELEMENT, with nauty's bit table.
+long is_table32(struct bench* b) {
+    int count = 0;
+    int i;
+    for(i = 0; i < POSITIONS; i++) {
+        count += IS_ELEMENT(b->set, b->positions[i]) != 0;
+    }
+    sink += count;
+    return POSITIONS;
+}
+
+long is_shift32(struct bench* b) {
+    int count = 0;
+    int i, pos;
+    for(i = 0; i < POSITIONS; i++) {
+        pos = b->positions[i];
+        count += (b->set[SETWD(pos)] & (0x80000000u >> SETBT(pos))) != 0;
+    }
+    sink += count;
+    return POSITIONS;
+}
+
+long is_shift64(struct bench* b) {
+    int count = 0;
+    int i, pos;
+    for(i = 0; i < POSITIONS; i++) {
+        pos = b->positions[i];
+        count += (b->set64[pos >> 6] >> (63 - (pos & 63))) & 1;
+    }
+    sink += count;
+    return POSITIONS;
+}
+
+// next_element over the whole set. An empty set counts as one step.
+long next_clz32(struct bench* b) {
+    long count = 0;
+    int i;
+    for(i = -1; (i = next_element(b->set, b->m, i)) >= 0;) {
+        count++;
+        sink += i;
+    }
+    return count ? count : 1;
+}
+
+long next_clz64(struct bench* b) {
+    long count = 0;
+    uint64_t word;
+    int w;
+    int bit;
+    for(w = 0; w < b->m64; w++) {
+        for(word = b->set64[w]; word; word ^= (uint64_t) 1 << (63 - bit)) {
+            bit = __builtin_clzll(word);
+            count++;
+            sink += w * 64 + bit;
+        }
+    }
+    return count ? count : 1;
+}
+
+long evaluate_dense(struct bench* b) {
+    sink += evaluate(&b->dense, b->orders[b->call++ % ORDERINGS], b->num_choice, b->num_dom, b->dom);
+    return 1;
+}
+
+long evaluate_sparse(struct bench* b) {
+    sink += evaluate(&b->sparse, b->orders[b->call++ % ORDERINGS], b->num_choice, b->num_dom, b->dom);
+    return 1;
+}
+
+long evaluate_lanes64(struct bench* b) {
+    sink += bitslice_evaluate(&b->lanes, b->orders[b->call++ % ORDERINGS], b->dom);
+    return LANES;
+}
+
+long evaluate_small(struct bench* b) {
+    sink += evaluate(&b->small, b->orders[b->call++ % ORDERINGS], b->num_choice, b->num_dom, b->dom);
+    return 1;
+}
+
+long greedy_lists(struct bench* b) {
+    sink += greedy_dom_set(&b->greedy, b->picks, b->dom);
+    return 1;
+}
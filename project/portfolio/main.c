@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// This program calculates a minimal dominating set for a graph given a heuristic and a time limit
+// The heuristic for this program is a portfolio: one thread per processor, each restarting
+// a different strategy, with the smallest set found by any thread kept.
+// Graphs are provided through standard input in the format specified by assignment 2.
+// Storage is sized for each graph as it is read, so there is no limit on its size.
+
+#include "../common/arena.h"
+#include "../common/graph.h"
+#include "../common/pipeline.h"
+#include "../common/timer.h"
+#include "../common/options.h"
+#include "../common/stats.h"
+#include "../common/dom_set.h"
+#include "../common/random.h"
+#include "../common/greedy.h"
+#include "../common/bfs.h"
+#include "../common/genetic.h"
+#include "../common/lower_bound.h"
+#include "../common/local_search.h"
+
+// The strategies, thread i runs strategy i % STRATEGY_COUNT.
+// SHUFFLE: random orderings, as project/random.
+// BFS: breadth first orderings from a random root, as project/bfs.
+// GREEDY: randomised max-coverage greedy with redundant members removed, as project/greedy.
+// LOCAL_SEARCH: one greedy set improved by local search for the whole time limit.
+// GENETIC: a generation of the genetic algorithm at a time, as project/custom on one thread.
+#define SHUFFLE 0
+#define BFS 1
+#define GREEDY 2
+#define LOCAL_SEARCH 3
+#define GENETIC 4
+#define STRATEGY_COUNT 5
+
+// State shared by every thread for the current graph.
+struct portfolio {
+    struct graph* G;
+    int* start; // closed neighbourhood lists, see closed_neighbourhoods
+    int* nbr;
+    uint64_t seed; // thread i uses random stream i + 1 of this seed
+    double time_limit; // seconds allowed for the graph
+    double start_time; // when the graph was started, see start_timer_at
+    int bound; // no dominating set is smaller than this, see lower_bound
+    atomic_int best_size; // smallest set found by any thread
+};
+
+// A thread running one strategy. It keeps the best set it found itself,
+// the best of these is printed once every thread has finished.
+struct worker {
+    struct portfolio* portfolio;
+    int id;
+    int strategy;
+    pthread_t thread;
+    int* p;
+    int* num_choice;
+    int* num_dom;
+    int* picks;
+    int* dom;
+    int* min_dom;
+    int min_size;
+    struct greedy greedy;
+    struct bfs bfs;
+    struct individual* generation; // GENETIC: the current and the next POP_SIZE individuals
+    struct individual* next;
+    int* used; // GENETIC: scratch space for next_generation
+    int generations; // GENETIC: generations evaluated so far
+};
+
+void* worker_run(void*);
+void genetic_generation(struct worker*);
+void record(struct worker*, int, int*);
+
+// Verbose output flag
+int verbose;
+
+int main(int argc, char* argv[]) {
+    uint64_t seed;
+    if(!parse_options(argc, argv, 3, &seed, &job_budget)) {
+         printf("Usage %s <maximum number of seconds per graph> <verbose> [--seed <seed>] [--budget <seconds for all graphs>] [--stats]\n", argv[0]);
+         return EXIT_FAILURE;
+    }
+    max_second = atoi(argv[1]);
+    verbose = atoi(argv[2]);
+    start_job();
+
+    struct pipeline pipeline; // reads and prints the graphs around the one being solved
+    struct pipeline_slot* slot; // the graph being solved and its storage
+    struct graph G; // compressed adjacency matrix form of a graph
+    struct portfolio portfolio;
+    struct worker* w;
+
+    // every strategy gets at least one thread
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    int thread_count = processors < STRATEGY_COUNT ? STRATEGY_COUNT : processors;
+    struct worker* workers = malloc(thread_count * sizeof(struct worker));
+    if(workers == NULL) {
+        printf("Unable to allocate the threads.\n");
+        return EXIT_FAILURE;
+    }
+
+    int i, j, best;
+    pipeline_start(&pipeline, verbose);
+    while((slot = pipeline_next(&pipeline)) != NULL) {
+        G = slot->G;
+        portfolio.time_limit = graph_time_limit(slot->start, slot->end);
+        portfolio.bound = lower_bound(&G, &slot->arena);
+
+        portfolio.G = &G;
+        portfolio.seed = seed;
+        atomic_init(&portfolio.best_size, G.vertex_count);
+        closed_neighbourhoods(&G, &slot->arena, &portfolio.start, &portfolio.nbr);
+
+        // the arena is not thread safe, so every worker is given its storage here
+        for(i = 0; i < thread_count; i++) {
+            w = &workers[i];
+            w->portfolio = &portfolio;
+            w->id = i;
+            w->strategy = i % STRATEGY_COUNT;
+            w->p = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+            w->num_choice = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+            w->num_dom = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+            w->picks = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+            w->dom = arena_alloc(&slot->arena, G.m * sizeof(int));
+            w->min_dom = arena_zalloc(&slot->arena, G.m * sizeof(int));
+            greedy_init(&w->greedy, G.vertex_count, portfolio.start, portfolio.nbr, &slot->arena);
+            bfs_init(&w->bfs, G.vertex_count, portfolio.start, portfolio.nbr, &slot->arena);
+            if(w->strategy == GENETIC) {
+                w->generation = arena_alloc(&slot->arena, 2 * POP_SIZE * sizeof(struct individual));
+                w->next = w->generation + POP_SIZE;
+                for(j = 0; j < 2 * POP_SIZE; j++) {
+                    w->generation[j].p = arena_alloc(&slot->arena, G.vertex_count * sizeof(int));
+                    w->generation[j].dom = arena_alloc(&slot->arena, G.m * sizeof(int));
+                }
+                w->used = arena_alloc(&slot->arena, G.m * sizeof(int));
+                w->generations = 0;
+            }
+        }
+
+        portfolio.start_time = start_timer();
+        stats_start(G.vertex_count);
+        for(i = 0; i < thread_count; i++) {
+            pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]);
+        }
+
+        best = 0;
+        for(i = 0; i < thread_count; i++) {
+            pthread_join(workers[i].thread, NULL);
+            if(workers[i].min_size < workers[best].min_size) {
+                best = i;
+            }
+        }
+
+        stats_report(slot->graph_num, G.vertex_count, workers[best].min_size, portfolio.bound);
+        pipeline_write(&pipeline, slot, workers[best].min_size, portfolio.bound, workers[best].min_dom);
+    }
+
+    free(workers);
+    pipeline_finish(&pipeline);
+    return EXIT_SUCCESS;
+}
+
+// Thread body, restarts the worker's strategy until the time limit.
+// Parameters:
+//   arg: the worker for this thread.
+void* worker_run(void* arg) {
+    struct worker* w = arg;
+    struct portfolio* portfolio = w->portfolio;
+    int n = portfolio->G->vertex_count;
+    int i, size;
+
+    seed_random(portfolio->seed, w->id + 1);
+    start_timer_at(portfolio->start_time);
+
+    w->min_size = n;
+    for(i = 0; i < n; i++) {
+        ADD_ELEMENT(w->min_dom, i);
+        w->p[i] = i;
+    }
+
+    do {
+        if(w->strategy == GENETIC) {
+            genetic_generation(w);
+            continue;
+        }
+
+        switch(w->strategy) {
+            case SHUFFLE:
+                shuffle(n, w->p);
+                break;
+            case BFS:
+                bfs_order(&w->bfs, w->p);
+                break;
+            default:
+                size = greedy_dom_set(&w->greedy, w->picks, w->dom);
+                record(w, size, w->dom);
+                greedy_order(&w->greedy, w->picks, size, w->p);
+                break;
+        }
+
+        size = evaluate(portfolio->G, w->p, w->num_choice, w->num_dom, w->dom);
+        stats_pass(1);
+        record(w, size, w->dom);
+
+        if(w->strategy == LOCAL_SEARCH) {
+            // local_search improves min_dom in place
+            w->min_size = local_search(portfolio->G, w->min_dom, w->min_size, portfolio->time_limit,
+                portfolio->bound, &portfolio->best_size);
+            record(w, w->min_size, w->min_dom);
+        }
+    } while(atomic_load(&portfolio->best_size) > portfolio->bound && !out_of_time(portfolio->time_limit));
+
+    return NULL;
+}
+
+// Evaluate the next generation of a GENETIC worker, the first being random orderings.
+// Parameters:
+//   w: the worker.
+void genetic_generation(struct worker* w) {
+    struct graph* G = w->portfolio->G;
+    struct individual* t;
+    int i;
+
+    // every ordering of fewer than two vertices gives the same set, and cannot be bred
+    if(!w->generations || G->vertex_count < 2) {
+        first_generation(G->vertex_count, w->generation);
+    } else {
+        next_generation(G->vertex_count, G->m, w->generation, w->next, w->used);
+        t = w->generation;
+        w->generation = w->next;
+        w->next = t;
+    }
+
+    for(i = 0; i < POP_SIZE; i++) {
+        w->generation[i].size = evaluate(G, w->generation[i].p, w->num_choice, w->num_dom, w->generation[i].dom);
+    }
+    stats_pass(POP_SIZE);
+    w->generations++;
+
+    qsort(w->generation, POP_SIZE, sizeof(struct individual), compare_fitness);
+    record(w, w->generation[0].size, w->generation[0].dom);
+}
+
+// Keep a set if it is the smallest this worker has found, and lower the shared best.
+// Parameters:
+//   w: the worker that found the set.
+//   size: the size of the set.
+//   dom: the set.
+void record(struct worker* w, int size, int* dom) {
+    if(size < w->min_size) {
+        w->min_size = size;
+        memcpy(w->min_dom, dom, w->portfolio->G->m * sizeof(int));
+        stats_found(size);
+    }
+
+    int best = atomic_load(&w->portfolio->best_size);
+    while(size < best && !atomic_compare_exchange_weak(&w->portfolio->best_size, &best, size)) {
+    }
+}
@@ -0,0 +1,446 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// This program solves graphs sent over a Unix domain socket, so a stream of small graphs
+// does not pay for starting a process for each one. It is built on the library of
+// project/lib: each worker thread keeps a context, and with it the buffers sized by the
+// graphs it has solved, for as long as the server runs.
+//   ./a.out serve <socket> [threads]: listen on the socket, one connection per thread at a time.
+//   ./a.out send <socket> <random|bfs|greedy|exact> <seconds per graph> [--seed <seed>]:
+//     send the graphs on standard input and print a line per graph as the programs do.
+//
+// A connection carries any number of requests, each answered before the next is read:
+//   solve <method> <seconds per graph> <seed> <bytes>
+// followed by that many bytes, at most REQUEST_MAX_BYTES, of graphs in the format of
+// assignment 2. A line is sent back for each graph as soon as it is solved:
+//   <graph> <vertices> <size> <bound> <members...>
+// then "done <graphs>". An invalid graph ends the request with
+//   error <graph> <reason>
+// and an invalid request line with "error 0 <reason>", which also closes the connection.
+// The seconds are those of ds_heuristic and ds_exact, so 0 is a single pass for the
+// heuristics and no limit for exact. A set exact proves minimum is sent with its size as bound.
+
+#include "../lib/domset.h"
+
+// Methods by name, in the order of DS_RANDOM, DS_BFS and DS_GREEDY, then the exact search.
+#define METHOD_COUNT 4
+#define EXACT 3
+const char* method_names[METHOD_COUNT] = {"random", "bfs", "greedy", "exact"};
+
+// Longest request line.
+#define LINE_MAX_LENGTH 256
+// Most bytes of graphs in one request, a larger one is refused before anything is allocated.
+#define REQUEST_MAX_BYTES ((size_t) 1 << 30)
+// Connections waiting to be accepted.
+#define BACKLOG 64
+
+// A thread serving connections, with storage kept from one request to the next.
+struct worker {
+    int listener;
+    pthread_t thread;
+    struct ds_context* ctx;
+    char* text; // the graphs of the request
+    size_t text_capacity;
+    int* set;
+    size_t set_capacity;
+    char* reply; // the line for a graph
+    size_t reply_capacity;
+};
+
+int serve(const char*, int);
+void* worker_run(void*);
+void serve_connection(struct worker*, int);
+int solve_request(struct worker*, int, int, double, uint64_t, size_t);
+int reply_line(struct worker*, int, int, int, int);
+int send_all(int, const char*, size_t);
+int send_error(int, int, const char*, const char*);
+int grow(void**, size_t*, size_t);
+int send_graphs(const char*, int, double, uint64_t);
+int open_socket(const char*, struct sockaddr_un*);
+int find_method(const char*);
+
+int main(int argc, char* argv[]) {
+    if(argc >= 3 && argc <= 4 && !strcmp(argv[1], "serve")) {
+        long threads = argc == 4 ? atol(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+        return serve(argv[2], threads < 1 ? 1 : threads);
+    }
+
+    uint64_t seed = 0;
+    if(argc == 7 && !strcmp(argv[5], "--seed")) {
+        seed = strtoull(argv[6], NULL, 10);
+        argc -= 2;
+    }
+    if(argc == 5 && !strcmp(argv[1], "send") && find_method(argv[3]) >= 0) {
+        return send_graphs(argv[2], find_method(argv[3]), atof(argv[4]), seed);
+    }
+
+    printf("Usage %s serve <socket> [threads]\n", argv[0]);
+    printf("      %s send <socket> <random|bfs|greedy|exact> <seconds per graph> [--seed <seed>]\n", argv[0]);
+    return EXIT_FAILURE;
+}
+
+// Listen on a socket and serve connections until killed.
+// A socket left behind by an earlier server is replaced, anything else at the path is not.
+// Parameters:
+//   path: the path of the socket.
+//   thread_count: the number of connections served at once.
+//
+// Returns EXIT_FAILURE if the server could not start.
+int serve(const char* path, int thread_count) {
+    struct sockaddr_un address;
+    struct stat st;
+    int i;
+
+    int listener = open_socket(path, &address);
+    if(listener < 0) {
+        return EXIT_FAILURE;
+    }
+    if(!lstat(path, &st) && S_ISSOCK(st.st_mode)) {
+        unlink(path);
+    }
+    if(bind(listener, (struct sockaddr*) &address, sizeof(address)) || listen(listener, BACKLOG)) {
+        printf("Unable to listen on %s: %s\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    struct worker* workers = calloc(thread_count, sizeof(struct worker));
+    if(workers == NULL) {
+        printf("Unable to allocate the threads.\n");
+        return EXIT_FAILURE;
+    }
+    for(i = 0; i < thread_count; i++) {
+        workers[i].listener = listener;
+        workers[i].ctx = ds_create();
+        if(workers[i].ctx == NULL || pthread_create(&workers[i].thread, NULL, worker_run, &workers[i])) {
+            printf("Unable to start thread %d.\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("Serving on %s with %d threads\n", path, thread_count);
+    fflush(stdout);
+    for(i = 0; i < thread_count; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    return EXIT_SUCCESS;
+}
+
+// Thread body, serves one connection at a time.
+// Parameters:
+//   arg: the worker for this thread.
+void* worker_run(void* arg) {
+    struct worker* w = arg;
+    int fd;
+
+    for(;;) {
+        fd = accept(w->listener, NULL, NULL);
+        if(fd < 0) {
+            if(errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            printf("Unable to accept a connection: %s\n", strerror(errno));
+            return NULL;
+        }
+        serve_connection(w, fd);
+    }
+}
+
+// Answer the requests of a connection until the client closes it, then close it.
+// Parameters:
+//   w: the worker.
+//   fd: the connection.
+void serve_connection(struct worker* w, int fd) {
+    char line[LINE_MAX_LENGTH];
+    char method[LINE_MAX_LENGTH];
+    double seconds;
+    unsigned long long seed;
+    size_t bytes;
+    int m;
+
+    FILE* in = fdopen(fd, "r");
+    if(in == NULL) {
+        close(fd);
+        return;
+    }
+
+    while(fgets(line, LINE_MAX_LENGTH, in) != NULL) {
+        if(sscanf(line, "solve %255s %lf %llu %zu", method, &seconds, &seed, &bytes) != 4
+            || (m = find_method(method)) < 0 || !(seconds >= 0)) {
+            send_error(fd, 0, "invalid request", line);
+            break;
+        }
+        if(bytes > REQUEST_MAX_BYTES) {
+            send_error(fd, 0, "request too large", line);
+            break;
+        }
+        if(!grow((void**) &w->text, &w->text_capacity, bytes + 1)) {
+            send_error(fd, 0, "out of memory", "for the graphs");
+            break;
+        }
+        if(fread(w->text, 1, bytes, in) != bytes) {
+            break;
+        }
+        if(!solve_request(w, fd, m, seconds, seed, bytes)) {
+            break;
+        }
+    }
+
+    fclose(in);
+}
+
+// Solve the graphs of a request, sending a line for each.
+// Parameters:
+//   w: the worker, with the graphs in w->text.
+//   fd: the connection.
+//   method: the method index in method_names.
+//   seconds: the time limit per graph.
+//   seed: the seed of the heuristics.
+//   length: the number of bytes of graphs.
+//
+// Returns 1 if the connection is still usable and 0 otherwise.
+int solve_request(struct worker* w, int fd, int method, double seconds, uint64_t seed, size_t length) {
+    size_t pos = 0;
+    size_t used;
+    int graph_num, status, n, size, bound;
+    char done[32];
+
+    for(graph_num = 1; ; graph_num++) {
+        status = ds_load_text(w->ctx, w->text + pos, length - pos, &used);
+        pos += used;
+        if(status == DS_END) {
+            break;
+        }
+        if(status != DS_OK) {
+            return send_error(fd, graph_num, ds_status_string(status), ds_message(w->ctx));
+        }
+
+        n = ds_vertex_count(w->ctx);
+        if(!grow((void**) &w->set, &w->set_capacity, ((size_t) n + 1) * sizeof(int))) {
+            return send_error(fd, graph_num, "out of memory", "for the set");
+        }
+
+        status = ds_lower_bound(w->ctx, &bound);
+        if(status == DS_OK && method == EXACT) {
+            status = ds_exact(w->ctx, seconds, w->set, &size);
+            if(status == DS_OK) {
+                bound = size;
+            }
+        } else if(status == DS_OK) {
+            status = ds_heuristic(w->ctx, method, seconds, seed, w->set, &size);
+        }
+        if(status < DS_OK) {
+            return send_error(fd, graph_num, ds_status_string(status), ds_message(w->ctx));
+        }
+
+        if(!reply_line(w, fd, graph_num, size, bound)) {
+            return 0;
+        }
+    }
+
+    snprintf(done, sizeof(done), "done %d\n", graph_num - 1);
+    return send_all(fd, done, strlen(done));
+}
+
+// Send the line for a solved graph.
+// Parameters:
+//   w: the worker, with the set in w->set.
+//   fd: the connection.
+//   graph_num: the graph number within the request.
+//   size: the size of the set.
+//   bound: the lower bound.
+//
+// Returns 1 if the line was sent and 0 otherwise.
+int reply_line(struct worker* w, int fd, int graph_num, int size, int bound) {
+    // at most 12 bytes per number
+    size_t length = 0;
+    int i;
+    if(!grow((void**) &w->reply, &w->reply_capacity, 12 * ((size_t) size + 4) + 1)) {
+        return 0;
+    }
+
+    length += sprintf(w->reply + length, "%d %d %d %d", graph_num, ds_vertex_count(w->ctx), size, bound);
+    for(i = 0; i < size; i++) {
+        length += sprintf(w->reply + length, " %d", w->set[i]);
+    }
+    w->reply[length++] = '\n';
+    return send_all(fd, w->reply, length);
+}
+
+// Write all of a buffer to a socket.
+// A client that has gone is an error rather than SIGPIPE.
+//
+// Returns 1 if it was written and 0 otherwise.
+int send_all(int fd, const char* buffer, size_t length) {
+    ssize_t sent;
+    while(length > 0) {
+        sent = send(fd, buffer, length, MSG_NOSIGNAL);
+        if(sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if(sent <= 0) {
+            return 0;
+        }
+        buffer += sent;
+        length -= sent;
+    }
+    return 1;
+}
+
+// Send an error line, without any newline in the detail.
+// Parameters:
+//   fd: the connection.
+//   graph_num: the graph the error is in, 0 for the request itself.
+//   reason: the kind of error.
+//   detail: what was wrong.
+//
+// Returns 1 if the connection is still usable, which it is after an invalid graph.
+int send_error(int fd, int graph_num, const char* reason, const char* detail) {
+    char line[LINE_MAX_LENGTH + 64];
+    snprintf(line, sizeof(line), "error %d %s: %.*s\n", graph_num, reason,
+        (int) strcspn(detail, "\r\n"), detail);
+    return send_all(fd, line, strlen(line)) && graph_num > 0;
+}
+
+// Make a buffer at least a given size, keeping its contents.
+// Parameters:
+//   buffer: the buffer, reallocated if too small.
+//   capacity: its size in bytes.
+//   needed: the bytes needed.
+//
+// Returns 1, or 0 if out of memory or doubling needed would wrap, leaving the buffer as it was.
+int grow(void** buffer, size_t* capacity, size_t needed) {
+    if(needed <= *capacity) {
+        return 1;
+    }
+    if(needed > SIZE_MAX / 2) {
+        return 0;
+    }
+
+    void* grown = realloc(*buffer, 2 * needed);
+    if(grown == NULL) {
+        return 0;
+    }
+    *buffer = grown;
+    *capacity = 2 * needed;
+    return 1;
+}
+
+// Send standard input to a server as one request and print a line per graph as it arrives,
+// in the form the programs print when not verbose.
+// Parameters:
+//   path: the path of the server's socket.
+//   method: the method index in method_names.
+//   seconds: the time limit per graph.
+//   seed: the seed of the heuristics.
+//
+// Returns EXIT_SUCCESS if every graph was solved and EXIT_FAILURE otherwise.
+int send_graphs(const char* path, int method, double seconds, uint64_t seed) {
+    struct sockaddr_un address;
+    char header[LINE_MAX_LENGTH];
+    char* text = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    size_t got;
+    int graph_num, n, size, bound, skip;
+
+    // the length goes first, so all of the input is read before sending
+    do {
+        if(!grow((void**) &text, &capacity, length + (1 << 20))) {
+            printf("Out of memory reading the input.\n");
+            return EXIT_FAILURE;
+        }
+        got = fread(text + length, 1, capacity - length, stdin);
+        length += got;
+    } while(got > 0);
+    if(length > REQUEST_MAX_BYTES) {
+        printf("The input is larger than the %zu bytes a request may hold.\n", REQUEST_MAX_BYTES);
+        return EXIT_FAILURE;
+    }
+
+    int fd = open_socket(path, &address);
+    if(fd < 0) {
+        return EXIT_FAILURE;
+    }
+    if(connect(fd, (struct sockaddr*) &address, sizeof(address))) {
+        printf("Unable to connect to %s: %s\n", path, strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    snprintf(header, sizeof(header), "solve %s %g %llu %zu\n", method_names[method], seconds,
+        (unsigned long long) seed, length);
+    if(!send_all(fd, header, strlen(header)) || !send_all(fd, text, length)) {
+        printf("Unable to send the graphs: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    free(text);
+
+    // each reply line is read whole, however long its set
+    FILE* in = fdopen(fd, "r");
+    char* line = NULL;
+    size_t line_capacity = 0;
+    int result = EXIT_FAILURE;
+    while(in != NULL && getline(&line, &line_capacity, in) > 0) {
+        if(sscanf(line, "%d %d %d %d", &graph_num, &n, &size, &bound) == 4) {
+            printf("%4d %4d   %3d   %3d %3d\n", graph_num, n, size, bound, size - bound);
+            fflush(stdout);
+        } else if(!strncmp(line, "done", 4)) {
+            result = EXIT_SUCCESS;
+            break;
+        } else {
+            skip = 0;
+            sscanf(line, "error %d %n", &graph_num, &skip);
+            printf("*** Error- %s", line + skip);
+            if(skip && graph_num > 0) {
+                printf("Graph   %5d: BAD GRAPH\n", graph_num);
+            }
+            break;
+        }
+    }
+
+    free(line);
+    if(in != NULL) {
+        fclose(in);
+    }
+    return result;
+}
+
+// Create a socket for a path.
+// Parameters:
+//   path: the path of the socket.
+//   address: a location to store its address.
+//
+// Returns the socket, or -1 after printing why not.
+int open_socket(const char* path, struct sockaddr_un* address) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(address->sun_path)) {
+        printf("Socket path %s is too long.\n", path);
+        return -1;
+    }
+    strcpy(address->sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) {
+        printf("Unable to create a socket: %s\n", strerror(errno));
+    }
+    return fd;
+}
+
+// Returns the index of a method in method_names, or -1 if there is none by that name.
+int find_method(const char* name) {
+    int i;
+    for(i = 0; i < METHOD_COUNT; i++) {
+        if(!strcmp(name, method_names[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
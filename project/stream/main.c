@@ -0,0 +1,404 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// This program finds dominating sets of graphs too large to hold in memory, even as
+// neighbour lists. The graphs are read from a file in the format of assignment 2 in a few
+// sequential passes, and only O(n) state is kept: the number of members dominating each
+// vertex, the members as a bitset and one neighbour list at a time.
+//   pass 1: check the graph and find its maximum degree.
+//   threshold passes: with t the largest power of two at most the maximum degree + 1,
+//     add each vertex whose closed neighbourhood holds at least t undominated vertices,
+//     then lower t by the step, half by default, and pass again. The last pass, with t = 1,
+//     dominates every vertex.
+//   last pass: drop each member whose closed neighbourhood is dominated twice.
+// With a step of s each vertex added covers at least s times what the max-coverage greedy's
+// choice would, so the set is within O(log maximum degree) of a minimum, like the greedy's.
+// A larger step comes closer to the greedy for more passes: 0.75 makes about 2.4 times as many.
+//
+// The check cannot keep the lists to look up uv for each vu, so symmetry is checked with
+// a fingerprint: a hash of every edge uv with u < v is summed as listed at u and at v,
+// and the sums differ if any edge is listed at only one end, except with probability 2^-64.
+//
+// Usage: ./a.out <graph file> <verbose> [--step <fraction>]. The file is read again for each pass, so it must be
+// a file rather than a pipe. With verbose 1 the set is printed as print_dom_set prints it;
+// the graph is not printed, as it is never held.
+
+#include "../common/bitset.h"
+#include "../common/output.h"
+
+// Bytes read from the file at a time.
+#define STREAM_BUFFER (1 << 20)
+
+// A file read sequentially in blocks.
+struct stream {
+    int fd;
+    char* buffer;
+    size_t size; // bytes in buffer
+    size_t pos; // index in buffer of the next byte to parse
+    off_t offset; // offset in the file of buffer[0]
+};
+
+// The state of a graph, O(n) however many edges it has.
+struct semi_external {
+    int vertex_count;
+    int max_degree;
+    off_t start; // offset of the graph in the file
+    int* num_dom; // members in the closed neighbourhood of each vertex
+    int* dom; // the members
+    int* list; // the neighbours of the vertex being read
+    int capacity; // vertices the arrays have room for
+    int undominated;
+};
+
+void stream_open(struct stream*, const char*);
+void stream_seek(struct stream*, off_t);
+int stream_int(struct stream*, int*);
+off_t stream_offset(struct stream*);
+int read_list(struct stream*, struct semi_external*, int);
+int check_pass(struct stream*, struct semi_external*, int);
+void threshold_pass(struct stream*, struct semi_external*, int);
+void prune_pass(struct stream*, struct semi_external*);
+void add_member(struct semi_external*, int, int);
+void bad_graph(int, const char*, int, int, int);
+uint64_t edge_hash(int, int);
+
+// Verbose output flag
+int verbose;
+
+int main(int argc, char* argv[]) {
+    double step = 0.5; // fraction of the threshold kept from one pass to the next
+    if(argc == 5 && !strcmp(argv[3], "--step")) {
+        step = atof(argv[4]);
+        argc -= 2;
+    }
+    if(argc != 3 || !(step > 0 && step < 1)) {
+        printf("Usage %s <graph file> <verbose> [--step <fraction of the threshold kept each pass>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    verbose = atoi(argv[2]);
+
+    struct stream stream;
+    struct semi_external se;
+    int graph_num, t, next, size, bound;
+
+    stream_open(&stream, argv[1]);
+    memset(&se, 0, sizeof(se));
+
+    for(graph_num = 1; check_pass(&stream, &se, graph_num); graph_num++) {
+        off_t end = stream_offset(&stream);
+
+        for(t = 1; t <= (se.max_degree + 1) / 2; t *= 2);
+        for(; t >= 1 && se.undominated; t = next) {
+            threshold_pass(&stream, &se, t);
+            next = t * step;
+            if(next == t) {
+                next--;
+            }
+            if(next < 1 && t > 1) {
+                next = 1; // a small step must not skip the pass with t = 1
+            }
+        }
+        prune_pass(&stream, &se);
+
+        size = set_size(se.vertex_count, se.dom);
+        // each member dominates at most max_degree + 1 vertices
+        bound = se.vertex_count ? (se.vertex_count + se.max_degree) / (se.max_degree + 1) : 0;
+        if(verbose) {
+            output_char('\n');
+            output_int(size, 5);
+            output_char('\n');
+            print_set(se.vertex_count, se.dom);
+            output_char('\n');
+            output_flush();
+        } else {
+            printf("%4d %4d   %3d   %3d %3d\n", graph_num, se.vertex_count, size, bound, size - bound);
+            fflush(stdout);
+        }
+
+        stream_seek(&stream, end);
+    }
+
+    close(stream.fd);
+    return EXIT_SUCCESS;
+}
+
+// Open a file for reading in sequential blocks, exits if it cannot be.
+void stream_open(struct stream* s, const char* path) {
+    s->fd = open(path, O_RDONLY);
+    s->buffer = malloc(STREAM_BUFFER);
+    if(s->fd < 0 || s->buffer == NULL) {
+        printf("Unable to read %s: %s\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    posix_fadvise(s->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    s->size = s->pos = 0;
+    s->offset = 0;
+}
+
+// Move to an offset in the file, exits if the file cannot be read from there.
+void stream_seek(struct stream* s, off_t offset) {
+    if(offset >= s->offset && offset <= s->offset + (off_t) s->size) {
+        s->pos = offset - s->offset;
+        return;
+    }
+    if(lseek(s->fd, offset, SEEK_SET) < 0) {
+        printf("Unable to seek in the graph file: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    s->size = s->pos = 0;
+    s->offset = offset;
+}
+
+// Returns the next byte without consuming it, or -1 at the end of the file.
+static inline int stream_byte(struct stream* s) {
+    ssize_t count;
+    if(s->pos == s->size) {
+        s->offset += s->size;
+        s->size = s->pos = 0;
+        do {
+            count = read(s->fd, s->buffer, STREAM_BUFFER);
+        } while(count < 0 && errno == EINTR);
+        if(count <= 0) {
+            return -1;
+        }
+        s->size = count;
+    }
+    return (unsigned char) s->buffer[s->pos];
+}
+
+// Read an integer as input_int does.
+// Parameters:
+//   s: the stream.
+//   d: space to read the integer into.
+//
+// Returns 1 if an integer was read, 0 at the end of the file or if the next
+// characters are not an integer or it does not fit in an int.
+int stream_int(struct stream* s, int* d) {
+    long long value = 0;
+    int negative = 0;
+    int digits = 0;
+    int c;
+
+    while((c = stream_byte(s)) == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+        s->pos++;
+    }
+    if(c == '-' || c == '+') {
+        negative = c == '-';
+        s->pos++;
+    }
+
+    while((c = stream_byte(s)) >= '0' && c <= '9') {
+        if(value <= INT_MAX) {
+            value = value * 10 + c - '0';
+        }
+        digits++;
+        s->pos++;
+    }
+
+    if(!digits || value > (negative ? -(long long) INT_MIN : INT_MAX)) {
+        return 0;
+    }
+    *d = negative ? -value : value;
+    return 1;
+}
+
+// Returns the offset in the file of the next byte to parse.
+off_t stream_offset(struct stream* s) {
+    return s->offset + s->pos;
+}
+
+// Read the neighbour list of a vertex into se->list.
+// Parameters:
+//   s: the stream, at the degree of the vertex.
+//   se: the graph state.
+//   graph_num: the current graph number for error logging.
+//
+// Returns the degree. Exits if the list cannot be read or is out of range;
+// the rest of the checks are made by check_pass.
+int read_list(struct stream* s, struct semi_external* se, int graph_num) {
+    int degree, i;
+    if(!stream_int(s, &degree)) {
+        bad_graph(graph_num, "Improper graph format, failed to read value.", 0, 0, 0);
+    }
+    if(degree < 0 || degree > se->vertex_count - 1) {
+        bad_graph(graph_num, "*** Error- invalid graph, degree %5d is not in the range [0, %5d]",
+            degree, se->vertex_count - 1, 0);
+    }
+    for(i = 0; i < degree; i++) {
+        if(!stream_int(s, &se->list[i])) {
+            bad_graph(graph_num, "Improper graph format, failed to read value.", 0, 0, 0);
+        }
+        if(se->list[i] < 0 || se->list[i] > se->vertex_count - 1) {
+            bad_graph(graph_num, "*** Error- invalid graph, value %5d is not in the range [0, %5d]",
+                se->list[i], se->vertex_count - 1, 0);
+        }
+    }
+    return degree;
+}
+
+// The first pass over a graph: read its vertex count, check it and find the maximum degree.
+// Leaves every vertex undominated and the set empty.
+// Parameters:
+//   s: the stream, at the start of the graph.
+//   se: the graph state, resized for the graph.
+//   graph_num: the current graph number for error logging.
+//
+// Returns 1 if a graph was read and 0 at the end of the file. Exits if the graph is not valid.
+int check_pass(struct stream* s, struct semi_external* se, int graph_num) {
+    int n, v, i, u, degree;
+    uint64_t forward = 0; // hashes of the edges uv listed at u, u < v
+    uint64_t backward = 0; // and listed at v
+
+    se->start = stream_offset(s);
+    if(!stream_int(s, &n)) {
+        return 0;
+    }
+    if(n < 0) {
+        bad_graph(graph_num, "Improper graph format, negative vertex count", 0, 0, 0);
+    }
+
+    if(n > se->capacity) {
+        free(se->num_dom);
+        free(se->dom);
+        free(se->list);
+        se->num_dom = malloc((size_t) n * sizeof(int));
+        se->dom = malloc((SET_WORDS(n) + 1) * sizeof(int));
+        se->list = malloc((size_t) n * sizeof(int));
+        if(se->num_dom == NULL || se->dom == NULL || se->list == NULL) {
+            printf("Out of memory allocating the state of %d vertices.\n", n);
+            exit(EXIT_FAILURE);
+        }
+        se->capacity = n;
+    }
+    se->vertex_count = n;
+    se->max_degree = 0;
+
+    // num_dom is the vertex each vertex was last listed at until the pass ends, to find multiple edges
+    for(v = 0; v < n; v++) {
+        se->num_dom[v] = -1;
+    }
+    for(v = 0; v < n; v++) {
+        degree = read_list(s, se, graph_num);
+        if(degree > se->max_degree) {
+            se->max_degree = degree;
+        }
+        for(i = 0; i < degree; i++) {
+            u = se->list[i];
+            if(u == v) {
+                bad_graph(graph_num, "*** Error- graph is not simple, loop at node %5d", v, 0, 0);
+            }
+            if(se->num_dom[u] == v) {
+                bad_graph(graph_num, "*** Error- graph is not simple, multiple edges between node %5d and node %5d",
+                    v, u, 0);
+            }
+            se->num_dom[u] = v;
+            if(v < u) {
+                forward += edge_hash(v, u);
+            } else {
+                backward += edge_hash(u, v);
+            }
+        }
+    }
+    if(forward != backward) {
+        bad_graph(graph_num, "*** Error- adjacency matrix is not symmetric", 0, 0, 0);
+    }
+
+    memset(se->num_dom, 0, (size_t) n * sizeof(int));
+    memset(se->dom, 0, (SET_WORDS(n) + 1) * sizeof(int));
+    se->undominated = n;
+    return 1;
+}
+
+// Add each vertex whose closed neighbourhood holds at least t undominated vertices.
+// Parameters:
+//   s: the stream.
+//   se: the graph state.
+//   t: the threshold.
+void threshold_pass(struct stream* s, struct semi_external* se, int t) {
+    int n, v, i, degree, gain;
+
+    stream_seek(s, se->start);
+    stream_int(s, &n);
+    for(v = 0; v < n && se->undominated; v++) {
+        degree = read_list(s, se, 0);
+        if(degree + 1 < t) {
+            continue;
+        }
+
+        gain = !se->num_dom[v];
+        for(i = 0; i < degree; i++) {
+            gain += !se->num_dom[se->list[i]];
+        }
+        if(gain >= t) {
+            add_member(se, v, degree);
+        }
+    }
+}
+
+// Drop each member whose closed neighbourhood is dominated by other members too.
+// Parameters:
+//   s: the stream.
+//   se: the graph state.
+void prune_pass(struct stream* s, struct semi_external* se) {
+    int n, v, i, degree, needed;
+
+    stream_seek(s, se->start);
+    stream_int(s, &n);
+    for(v = 0; v < n; v++) {
+        degree = read_list(s, se, 0);
+        if(!IS_ELEMENT(se->dom, v) || se->num_dom[v] < 2) {
+            continue;
+        }
+
+        needed = 0;
+        for(i = 0; i < degree && !needed; i++) {
+            needed = se->num_dom[se->list[i]] < 2;
+        }
+        if(!needed) {
+            DEL_ELEMENT(se->dom, v);
+            se->num_dom[v]--;
+            for(i = 0; i < degree; i++) {
+                se->num_dom[se->list[i]]--;
+            }
+        }
+    }
+}
+
+// Add a vertex to the set.
+// Parameters:
+//   se: the graph state, with the neighbours of v in se->list.
+//   v: the vertex.
+//   degree: the degree of v.
+void add_member(struct semi_external* se, int v, int degree) {
+    int i;
+    ADD_ELEMENT(se->dom, v);
+    se->undominated -= !se->num_dom[v]++;
+    for(i = 0; i < degree; i++) {
+        se->undominated -= !se->num_dom[se->list[i]]++;
+    }
+}
+
+// Report an invalid graph and exit.
+// Parameters:
+//   graph_num: the current graph number.
+//   format: the message, as for printf, with up to three integers.
+void bad_graph(int graph_num, const char* format, int a, int b, int c) {
+    output_flush();
+    printf(format, a, b, c);
+    printf("\nGraph   %5d: BAD GRAPH\n", graph_num);
+    exit(EXIT_FAILURE);
+}
+
+// Returns a 64 bit hash of the edge uv, from the finaliser of splitmix64.
+uint64_t edge_hash(int u, int v) {
+    uint64_t x = (uint64_t) (uint32_t) u << 32 | (uint32_t) v;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}